@@ -0,0 +1,145 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <SDL.h>
+#include "AIBenchmark.h"
+#include "../Engine/Game.h"
+#include "../Engine/Logger.h"
+#include "../Engine/PhaseTimer.h"
+#include "../Engine/RNG.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/SavedBattleGame.h"
+
+namespace OpenXcom
+{
+
+int AIBenchmark::_turnsPlayed = 0;
+std::chrono::steady_clock::time_point AIBenchmark::_start;
+
+/**
+ * Prepares options before game is created: no window, no sound, no delays
+ * and nothing that waits for player input.
+ * Changed options are not saved, game skip saving them in benchmark mode.
+ */
+void AIBenchmark::setup()
+{
+	SDL_putenv((char*)"SDL_VIDEODRIVER=dummy");
+	SDL_putenv((char*)"SDL_AUDIODRIVER=dummy");
+	Options::mute = true;
+	Options::FPS = 0;
+	Options::FPSInactive = 0;
+	Options::battleXcomSpeed = 1;
+	Options::battleAlienSpeed = 1;
+	Options::battleInstantGrenade = true;
+	Options::battleNotifyDeath = false;
+	Options::noAlienPanicMessages = true;
+	Options::skipNextTurnScreen = true;
+	Options::autoCombat = true;
+	Options::autoCombatEachCombat = true;
+	Options::autoCombatEachTurn = true;
+	Options::autoCombatControlPerUnit = false;
+	Options::traceAI = false;
+	PhaseTimer::setEnabled(true);
+}
+
+/**
+ * Starts measuring after save is loaded, seed from command line replace one stored in save.
+ * @param game Pointer to the game.
+ */
+void AIBenchmark::start(Game* game)
+{
+	if (!game->getSavedGame() || !game->getSavedGame()->getSavedBattle())
+	{
+		Log(LOG_ERROR) << "Benchmark needs save of battle";
+		game->quit();
+		return;
+	}
+	Uint64 seed;
+	if (Options::getBenchmarkSeed(seed))
+	{
+		RNG::setSeed(seed);
+	}
+	_turnsPlayed = 0;
+	PhaseTimer::reset();
+	_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * Counts turn when all sides have played, quits game when all requested turns were played.
+ * @param game Pointer to the game.
+ * @param save Pointer to the battle.
+ */
+void AIBenchmark::turnEnded(Game* game, SavedBattleGame* save)
+{
+	if (save->getSide() != FACTION_PLAYER)
+	{
+		return;
+	}
+	if (++_turnsPlayed >= Options::getBenchmarkTurns())
+	{
+		report("all turns played");
+		game->quit();
+	}
+}
+
+/**
+ * Reports and quits when battle ended before all turns were played.
+ * @param game Pointer to the game.
+ */
+void AIBenchmark::battleFinished(Game* game)
+{
+	report("battle finished");
+	game->quit();
+}
+
+/**
+ * Writes time spent in each phase to log and standard output.
+ * @param reason Why benchmark ended.
+ */
+void AIBenchmark::report(const char* reason)
+{
+	const double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count();
+	const int turns = std::max(_turnsPlayed, 1);
+
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	ss << "Benchmark ended (" << reason << ") after " << _turnsPlayed << " turns, seed " << RNG::getSeed()
+		<< ", realistic accuracy " << (Options::battleRealisticAccuracy ? "on" : "off") << ", brutal AI " << (Options::brutalAI ? "on" : "off") << "\n";
+	ss << "  " << std::left << std::setw(16) << "wall time" << std::right << std::setw(12) << total << " ms" << std::setw(12) << total / turns << " ms/turn\n";
+	for (int i = 0; i < TP_MAX; ++i)
+	{
+		const TimedPhase phase = (TimedPhase)i;
+		const double ms = PhaseTimer::getMilliseconds(phase);
+		ss << "  " << std::left << std::setw(16) << PhaseTimer::getName(phase) << std::right << std::setw(12) << ms << " ms" << std::setw(12) << ms / turns << " ms/turn" << std::setw(12) << PhaseTimer::getCalls(phase) << " calls\n";
+	}
+	for (int i = 0; i < CC_MAX; ++i)
+	{
+		const CountedCache cache = (CountedCache)i;
+		const Uint64 hits = PhaseTimer::getCacheHits(cache);
+		const Uint64 misses = PhaseTimer::getCacheMisses(cache);
+		const double ratio = hits + misses ? 100.0 * hits / (hits + misses) : 0.0;
+		ss << "  " << std::left << std::setw(16) << PhaseTimer::getCacheName(cache) << std::right << std::setw(12) << hits << " hits" << std::setw(10) << misses << " misses" << std::setw(10) << ratio << " %\n";
+	}
+	Log(LOG_INFO) << ss.str();
+	std::cout << ss.str() << std::flush;
+}
+
+}
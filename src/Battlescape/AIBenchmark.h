@@ -0,0 +1,54 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+class Game;
+class SavedBattleGame;
+
+/**
+ * Headless benchmark of AI turns, started by `-benchmark TURNS -load SAVE`.
+ * Game runs without window or sound, AI controls both sides,
+ * and after given number of turns time spent in each phase is reported and game quits.
+ */
+class AIBenchmark
+{
+	static int _turnsPlayed;
+	static std::chrono::steady_clock::time_point _start;
+
+	/// Writes report of all phases.
+	static void report(const char* reason);
+public:
+	/// Is benchmark requested on command line?
+	static bool isActive() { return Options::getBenchmarkTurns() > 0; }
+	/// Prepares options before game is created.
+	static void setup();
+	/// Starts measuring after save is loaded.
+	static void start(Game* game);
+	/// Counts finished turn, quits when all requested turns were played.
+	static void turnEnded(Game* game, SavedBattleGame* save);
+	/// Reports and quits when battle ended before all turns were played.
+	static void battleFinished(Game* game);
+};
+
+}
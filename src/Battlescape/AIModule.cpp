@@ -29,7 +29,9 @@
 #include "Pathfinding.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Logger.h"
+#include "../Engine/PhaseTimer.h"
 #include "../Engine/Game.h"
+#include "../Engine/ParallelFor.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
@@ -426,6 +428,7 @@ bool AIModule::medikit_think(BattleMediKitType healOrStim)
  */
 void AIModule::think(BattleAction *action)
 {
+	PhaseTimer::Scope phaseScope(TP_AI);
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
@@ -3781,8 +3784,12 @@ void AIModule::brutalThink(BattleAction* action)
 		if (pathThroughLift && targetPosition.z > myPos.z && !IAmMindControlled)
 			enemyHasHighGround = true;
 
-		for (auto pu : _allPathFindingNodes)
+		bool peakScoresNeeded = !sweepMode && !enemyHasHighGround && !Options::aiPerformanceOptimization && canStartPeak(myMaxTU, myTile);
+		std::vector<CandidateScores> candidateScores = scoreCandidates(pathToEnemyPositions, peakScoresNeeded);
+		for (size_t candidate = 0; candidate < _allPathFindingNodes.size(); ++candidate)
 		{
+			PathfindingNode* pu = _allPathFindingNodes[candidate];
+			const CandidateScores& scores = candidateScores[candidate];
 			Position pos = pu->getPosition();
 			Tile* tile = _save->getTile(pos);
 			if (tile == NULL)
@@ -4019,7 +4026,7 @@ void AIModule::brutalThink(BattleAction* action)
 						me.attackPotential *= exposureMod;
 					}
 					me.bestDirection = _save->getTileEngine()->getDirectionTo(pos, currentAttackDirection);
-					if (pu->getPrevNode() && !isPositionVisibleToEnemy(pu->getPrevNode()->getPosition()))
+					if (pu->getPrevNode() && !scores.prevNodeVisibleToEnemy)
 						currLastStepCost = pu->getTUCost(false).time - pu->getPrevNode()->getTUCost(false).time;
 				}
 			}
@@ -4044,32 +4051,16 @@ void AIModule::brutalThink(BattleAction* action)
 					directPeakScore = remainingTimeUnits;
 					me.IsDirectPeak = true;
 				}
-				else if (enoughTUToPeak && !pathInvolvesFalling && !_unit->isCheatOnMovement() && (myMaxTU == _unit->getTimeUnits() || _save->getTileEngine()->isNextToDoor(myTile)))
+				else if (enoughTUToPeak && !pathInvolvesFalling && canStartPeak(myMaxTU, myTile))
 				{
-					bool viable = !tile->hasNoFloor();
-					if (pos.x == myPos.x && pos.y == myPos.y)
-					{
-						viable = true;
-					}
-					else
-					{
-						for (Position pathToEnemyPos : pathToEnemyPositions)
-						{
-							if (pos == pathToEnemyPos)
-							{
-								viable = true;
-								break;
-							}
-						}
-					}
-					if (viable)
+					if (isPeakViable(pos, myPos, pathToEnemyPositions))
 					{
 						int highestVisibleTiles = 0;
 						if (!Options::aiPerformanceOptimization)
 						{
 							for (int i = 0; i < 8; i++)
 							{
-								float currentVisibleTiles = scoreVisibleTiles(_save->getTileEngine()->visibleTilesFrom(_unit, pos, i, true));
+								float currentVisibleTiles = scores.hasPeakTiles ? scores.peakTiles[i] : scoreVisibleTiles(_save->getTileEngine()->visibleTilesFrom(_unit, pos, i, true));
 								if (currentVisibleTiles > highestVisibleTiles)
 								{
 									highestVisibleTiles = currentVisibleTiles;
@@ -4118,7 +4109,7 @@ void AIModule::brutalThink(BattleAction* action)
 						break;
 					}
 				}
-				if (!isNode && getCoverValue(tile, _unit, 3) == 0)
+				if (!isNode && scores.cover == 0)
 					validCover = false;
 			}
 			if (!sweepMode && validCover)
@@ -5600,6 +5591,36 @@ bool AIModule::quickLineOfFire(Position pos, BattleUnit* target, bool beOkayWith
 	// In fleeMode we don't ignore ourselves because otherwise we think we can take cover behind ourselves
 	if (fleeMode && pos != _unit->getPosition())
 		unitToIgnore = NULL;
+	VisibilityMemo &memo = _save->getTileEngine()->getVisibilityMemo();
+	VisibilityMemoKey key;
+	key.origin = pos;
+	key.target = targetPosition;
+	key.unitA = unitToIgnore ? unitToIgnore->getId() : -1;
+	key.unitB = target->getId();
+	key.flags = beOkayWithFriendOfTarget;
+	key.type = VMT_LINE_OF_FIRE;
+	const Position targetCorner = targetPosition + Position(target->getArmor()->getSize() - 1, target->getArmor()->getSize() - 1, 0);
+	float memoValue = 0.0f;
+	if (memo.find(key, pos, targetCorner, memoValue))
+	{
+		return memoValue > 0.0f;
+	}
+	const bool result = quickLineOfFireHelper(originVoxel, targetPosition, target, unitToIgnore, beOkayWithFriendOfTarget);
+	memo.store(key, pos, targetCorner, result);
+	return result;
+}
+
+/**
+ * Traces lines of fire from origin to every tile of target.
+ * @param originVoxel Origin of lines.
+ * @param targetPosition Position where target is assumed to be.
+ * @param target Target unit.
+ * @param unitToIgnore Unit that do not block lines.
+ * @param beOkayWithFriendOfTarget Hitting ally of target counts as success.
+ * @return Whether any line reach target.
+ */
+bool AIModule::quickLineOfFireHelper(Position originVoxel, Position targetPosition, BattleUnit* target, BattleUnit* unitToIgnore, bool beOkayWithFriendOfTarget)
+{
 	for (int x = 0; x < target->getArmor()->getSize(); ++x)
 		for (int y = 0; y < target->getArmor()->getSize(); ++y)
 		{
@@ -5631,6 +5652,17 @@ bool AIModule::quickLineOfFire(Position pos, BattleUnit* target, bool beOkayWith
  */
 bool AIModule::clearSight(Position pos, Position target)
 {
+	VisibilityMemo &memo = _save->getTileEngine()->getVisibilityMemo();
+	VisibilityMemoKey key;
+	key.origin = pos;
+	key.target = target;
+	key.unitA = _unit->getId();
+	key.type = VMT_CLEAR_SIGHT;
+	float memoValue = 0.0f;
+	if (memo.find(key, pos, target, memoValue))
+	{
+		return memoValue > 0.0f;
+	}
 	Tile *tile = _save->getTile(pos);
 	Tile *targetTile = _save->getTile(target);
 	Position originVoxel = pos.toVoxel() + TileEngine::voxelTileCenter;
@@ -5638,9 +5670,9 @@ bool AIModule::clearSight(Position pos, Position target)
 	Position targetVoxel = target.toVoxel() + TileEngine::voxelTileCenter;
 	targetVoxel.z -= targetTile->getTerrainLevel();
 	std::vector<Position> trajectory;
-	if (_save->getTileEngine()->calculateLineVoxel(originVoxel, targetVoxel, false, &trajectory, _unit, NULL, false) == V_EMPTY)
-		return true;
-	return false;
+	const bool result = _save->getTileEngine()->calculateLineVoxel(originVoxel, targetVoxel, false, &trajectory, _unit, NULL, false) == V_EMPTY;
+	memo.store(key, pos, target, result);
+	return result;
 }
 
 /**
@@ -6751,9 +6783,15 @@ bool AIModule::hasTileSight(Position from, Position to)
 {
 	if (from == to)
 		return true;
-	if (_save->getTileEngine()->hasEntry(from, to))
+	VisibilityMemo &memo = _save->getTileEngine()->getVisibilityMemo();
+	VisibilityMemoKey key;
+	key.origin = from;
+	key.target = to;
+	key.type = VMT_TILE_SIGHT;
+	float memoValue = 0.0f;
+	if (memo.find(key, from, to, memoValue))
 	{
-		return _save->getTileEngine()->getVisibilityCache(from, to);
+		return memoValue > 0.0f;
 	}
 	Tile* tile = _save->getTile(from);
 	if (!tile)
@@ -6770,12 +6808,17 @@ bool AIModule::hasTileSight(Position from, Position to)
 		to.z += 1;
 	if (_save->getTileEngine()->calculateLineTile(from, to, trajectory, 10) > 0)
 		result = false;
-	_save->getTileEngine()->setVisibilityCache(from, to, result);
+	key.origin = from;
+	key.target = to;
+	memo.store(key, from, to, result);
 	// Set visibility cache for each position in the trajectory
 	if (result)
 	{
 		for (const Position& position : trajectory)
-			_save->getTileEngine()->setVisibilityCache(position, to, result);
+		{
+			key.origin = position;
+			memo.store(key, position, to, result);
+		}
 	}
 	return result;
 }
@@ -7297,6 +7340,86 @@ bool AIModule::isPositionVisibleToEnemy(Position pos)
 	return false;
 }
 
+/**
+ * Checks if unit is in state to peek this turn, independent of candidate position.
+ * @param myMaxTU Maximum TU of unit.
+ * @param myTile Tile where unit stands.
+ * @return True if peeking can be considered.
+ */
+bool AIModule::canStartPeak(int myMaxTU, Tile* myTile)
+{
+	return !_unit->isCheatOnMovement() && (myMaxTU == _unit->getTimeUnits() || _save->getTileEngine()->isNextToDoor(myTile));
+}
+
+/**
+ * Checks if position is worth peeking from, positions in the air are only good when on our path to enemy.
+ * @param pos Candidate position.
+ * @param myPos Current position of unit.
+ * @param pathToEnemyPositions Positions on path to enemy.
+ * @return True if peeking from position make sense.
+ */
+bool AIModule::isPeakViable(Position pos, Position myPos, const std::vector<Position>& pathToEnemyPositions)
+{
+	if (pos.x == myPos.x && pos.y == myPos.y)
+		return true;
+	if (!_save->getTile(pos)->hasNoFloor())
+		return true;
+	for (Position pathToEnemyPos : pathToEnemyPositions)
+	{
+		if (pos == pathToEnemyPos)
+			return true;
+	}
+	return false;
+}
+
+/**
+ * Computes read only scores of all nodes in _allPathFindingNodes, split between worker threads.
+ * Battle is only read while this runs, each thread writes only scores of its own nodes
+ * and its own scratch marks of FOV lines, shared fan of lines is prepared before threads start.
+ * Results are the same as computed one by one and the serial evaluation consumes them in original order.
+ * @param pathToEnemyPositions Positions on path to enemy.
+ * @param withPeak Whether visible tiles in every direction are needed for peeking.
+ * @return Scores indexed same as _allPathFindingNodes.
+ */
+std::vector<CandidateScores> AIModule::scoreCandidates(const std::vector<Position>& pathToEnemyPositions, bool withPeak)
+{
+	std::vector<CandidateScores> scores(_allPathFindingNodes.size(), CandidateScores{});
+	const Position myPos = _unit->getPosition();
+	if (withPeak)
+	{
+		_save->getTileEngine()->reserveTilesInFOV(_unit->getArmor()->getSize());
+	}
+	parallelFor((int)_allPathFindingNodes.size(), getWorkerThreadsCount(Options::aiThreads), 8,
+		[&](int begin, int end)
+		{
+			TileRayFan::Marks marks;
+			for (int i = begin; i < end; ++i)
+			{
+				PathfindingNode* pu = _allPathFindingNodes[i];
+				CandidateScores& score = scores[i];
+				Tile* tile = _save->getTile(pu->getPosition());
+				if (tile == NULL)
+					continue;
+				if (pu->getTUCost(false).time > _unit->getTimeUnits() || pu->getTUCost(false).energy > _unit->getEnergy())
+					continue;
+				if (Options::aiPerformanceOptimization)
+					score.cover = getCoverValue(tile, _unit, 3);
+				if (pu->getPrevNode())
+					score.prevNodeVisibleToEnemy = isPositionVisibleToEnemy(pu->getPrevNode()->getPosition());
+				if (withPeak && isPeakViable(pu->getPosition(), myPos, pathToEnemyPositions))
+				{
+					for (int dir = 0; dir < 8; ++dir)
+					{
+						score.peakTiles[dir] = scoreVisibleTiles(_save->getTileEngine()->visibleTilesFrom(_unit, pu->getPosition(), dir, true, true, &marks));
+					}
+					score.hasPeakTiles = true;
+				}
+			}
+		}
+	);
+	return scores;
+}
+
 void AIModule::allowAttack(bool allow)
 {
 	_allowedToCheckAttack = allow;
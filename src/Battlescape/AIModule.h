@@ -34,6 +34,7 @@ class BattleUnit;
 struct BattleAction;
 class BattlescapeState;
 class Node;
+struct CandidateScores;
 
 enum AIMode { AI_PATROL, AI_AMBUSH, AI_COMBAT, AI_ESCAPE };
 enum AIAttackWeight : int
@@ -191,6 +192,8 @@ public:
 	float brutalExplosiveEfficacy(Position targetPos, BattleUnit *attackingUnit, int radius, bool grenade = false, bool validOnly = false) const;
 	/// An inaccurate simplified check for line of fire from a specific position to a specific target
 	bool quickLineOfFire(Position pos, BattleUnit *target, bool beOkayWithFriendOfTarget = false, bool lastLocationMode = false, bool fleeMode = false);
+	/// Traces lines of fire to each tile of target, used by quickLineOfFire.
+	bool quickLineOfFireHelper(Position originVoxel, Position targetPosition, BattleUnit *target, BattleUnit *unitToIgnore, bool beOkayWithFriendOfTarget);
 	/// checks whether there is clear sight between two tile-positions
 	bool clearSight(Position pos, Position target);
 	/// how many time-units would it take to turn to a specific target
@@ -281,6 +284,12 @@ public:
 	float damagePotential(Position pos, BattleUnit* target, int tuTotal, int energyTotal);
 	/// checks if a position is visible to the enemy
 	bool isPositionVisibleToEnemy(Position pos);
+	/// checks if unit is in state to peek this turn at all
+	bool canStartPeak(int myMaxTU, Tile* myTile);
+	/// checks if position is worth peeking from
+	bool isPeakViable(Position pos, Position myPos, const std::vector<Position>& pathToEnemyPositions);
+	/// computes read only scores of all candidate positions on worker threads
+	std::vector<CandidateScores> scoreCandidates(const std::vector<Position>& pathToEnemyPositions, bool withPeak);
 	/// allows or forbids attacking without another movement-logic-check
 	void allowAttack(bool allow);
 };
@@ -301,4 +310,15 @@ struct MoveEvaluation
 	float additiveMod;
 };
 
+/**
+ * Read only scores of one candidate position, computed in parallel before candidates are evaluated.
+ */
+struct CandidateScores
+{
+	float cover;
+	int peakTiles[8];
+	bool hasPeakTiles;
+	bool prevNodeVisibleToEnemy;
+};
+
 }
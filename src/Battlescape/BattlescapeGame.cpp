@@ -59,6 +59,7 @@
 #include "../Savegame/BattleUnitStatistics.h"
 #include "ConfirmEndMissionState.h"
 #include "../fmath.h"
+#include "AIBenchmark.h"
 
 namespace OpenXcom
 {
@@ -543,7 +544,7 @@ bool BattlescapeGame::kneel(BattleUnit *bu)
 		kneel.Time = tu;
 		if (kneel.spendTU())
 		{
-			bu->kneel(!bu->isKneeled());
+			bu->kneel(!bu->isKneeled(), _save);
 			// kneeling or standing up can reveal new terrain or units. I guess.
 			getTileEngine()->calculateFOV(bu->getPosition(), 1, false); //Update unit FOV for everyone through this position, skip tiles.
 			_parentState->updateSoldierInfo(); //This also updates the tile FOV of the unit, hence why it's skipped above.
@@ -672,6 +673,8 @@ void BattlescapeGame::endTurn()
 
 
 		_save->endTurn();
+		// new turn changes wounds, stun and script tags of units even without next turn screen
+		getMap()->invalidateUnitSprites();
 		t = _save->getTileEngine()->checkForTerrainExplosions();
 		if (t)
 		{
@@ -757,6 +760,11 @@ void BattlescapeGame::endTurn()
 		_parentState->getGame()->pushState(new NextTurnState(_save, _parentState));
 	}
 	_endTurnRequested = false;
+
+	if (AIBenchmark::isActive())
+	{
+		AIBenchmark::turnEnded(_parentState->getGame(), _save);
+	}
 }
 
 
@@ -2523,6 +2531,7 @@ void BattlescapeGame::removeSummonedPlayerUnits()
 			}
 
 			bu->setTile(nullptr, _save);
+			bu->clearVisibleTiles();
 			_save->clearUnitSelection(bu);
 			delete bu;
 			buIt = _save->getUnits()->erase(buIt);
@@ -90,6 +90,7 @@
 #include "../Mod/RuleVideo.h"
 #include <algorithm>
 #include "../Basescape/SoldiersAIState.h"
+#include "AIBenchmark.h"
 
 namespace OpenXcom
 {
@@ -800,6 +801,8 @@ void BattlescapeState::init()
 	_animTimer->start();
 	_gameTimer->start();
 	_map->setFocus(true);
+	// popup states (medikit, inventory, ...) can change units without making battle busy
+	_map->invalidateUnitSprites();
 	_map->draw();
 	_battleGame->init();
 	updateSoldierInfo();
@@ -3495,6 +3498,12 @@ void BattlescapeState::popup(State *state)
  */
 void BattlescapeState::finishBattle(bool abort, int inExitArea)
 {
+	if (AIBenchmark::isActive())
+	{
+		AIBenchmark::battleFinished(_game);
+		return;
+	}
+
 	bool isPreview = _save->isPreview();
 
 	while (!_game->isState(this))
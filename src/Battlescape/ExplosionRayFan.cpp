@@ -0,0 +1,164 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cmath>
+#include "ExplosionRayFan.h"
+#include "Pathfinding.h"
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Helper struct used while building tree.
+ */
+struct BuildNode
+{
+	Position offset;
+	Uint8 skip;
+	Uint16 ray;
+	std::vector<int> children;
+};
+
+/**
+ * Stores subtree of build node in preorder.
+ */
+void flattenNode(const std::vector<BuildNode>& build, int index, int parent, int depth, std::vector<ExplosionRayFan::Node>& nodes)
+{
+	const int self = (int)nodes.size();
+	const Position step = parent >= 0 ? build[index].offset - nodes[parent].offset : Position(0, 0, 0);
+	ExplosionRayFan::Node node = { };
+	node.offset = build[index].offset;
+	node.step = step;
+	node.dir = (Sint8)Pathfinding::vectorToDirection(step);
+	node.skip = build[index].skip;
+	node.ray = build[index].ray;
+	node.depth = depth;
+	node.parent = parent;
+	nodes.push_back(node);
+	for (int child : build[index].children)
+	{
+		flattenNode(build, child, self, depth + 1, nodes);
+	}
+	nodes[self].end = (Sint32)nodes.size();
+}
+
+/**
+ * Gets mask of big walls in center that ray with given azimuth skips on its first step.
+ * @param te Azimuth in degrees.
+ * @return Mask of `ExplosionRayFan::Skip*` flags.
+ */
+Uint8 getSkipMask(int te)
+{
+	Uint8 skip = 0;
+	if (te >= 135 && te < 315)
+		skip |= ExplosionRayFan::SkipNESWNegative;
+	if (te < 135 || te > 315)
+		skip |= ExplosionRayFan::SkipNESWPositive;
+	if (te < 45 || te > 225)
+		skip |= ExplosionRayFan::SkipNWSENegative;
+	if (te >= 45 && te < 225)
+		skip |= ExplosionRayFan::SkipNWSEPositive;
+	return skip;
+}
+
+}
+
+/**
+ * Creates empty fan, it need `reserve` before use.
+ */
+ExplosionRayFan::ExplosionRayFan()
+{
+
+}
+
+/**
+ * Cleans up the fan.
+ */
+ExplosionRayFan::~ExplosionRayFan()
+{
+
+}
+
+/**
+ * Builds all explosion rays up to given number of steps.
+ * Fan is only rebuilt when it is not long enough yet.
+ * @param depth Number of steps from center.
+ */
+void ExplosionRayFan::reserve(int depth)
+{
+	if (depth <= _depth)
+	{
+		return;
+	}
+	_depth = depth;
+
+	std::vector<BuildNode> build;
+	build.push_back(BuildNode{ Position(0, 0, 0), 0, 0, { } });
+
+	int ray = 0;
+	for (int fi = -90; fi <= 90; fi += 5)
+	{
+		// raytrace every 3 degrees makes sure we cover all tiles in a circle.
+		for (int te = 0; te <= 360; te += 3, ++ray)
+		{
+			const double cos_te = cos(Deg2Rad(te));
+			const double sin_te = sin(Deg2Rad(te));
+			const double sin_fi = sin(Deg2Rad(fi));
+			const double cos_fi = cos(Deg2Rad(fi));
+			const Uint8 skip = getSkipMask(te);
+
+			int current = 0;
+			for (int l = 1; l <= _depth; ++l)
+			{
+				const Position offset = Position(
+					int(floor(0.5 + l * sin_te * cos_fi)),
+					int(floor(0.5 + l * cos_te * cos_fi)),
+					int(floor(0.5 + l * sin_fi))
+				);
+				// only first step depends on azimuth, deeper steps are separated by their parents
+				const Uint8 stepSkip = l == 1 ? skip : 0;
+				int next = -1;
+				for (int child : build[current].children)
+				{
+					if (build[child].offset == offset && build[child].skip == stepSkip)
+					{
+						next = child;
+						break;
+					}
+				}
+				if (next == -1)
+				{
+					next = (int)build.size();
+					build.push_back(BuildNode{ offset, stepSkip, (Uint16)ray, { } });
+					build[current].children.push_back(next);
+				}
+				current = next;
+			}
+		}
+	}
+
+	_nodes.clear();
+	_nodes.reserve(build.size());
+	flattenNode(build, 0, -1, 0, _nodes);
+}
+
+}
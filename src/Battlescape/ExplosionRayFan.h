@@ -0,0 +1,108 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Precomputed fan of explosion rays.
+ * Explosion casts rays every 3 degrees of azimuth and 5 degrees of elevation, each stepping one tile length at time.
+ * Tiles hit by ray depend only on its direction, so all rays are traced once and merged into a tree by their common beginning,
+ * tile near center of explosion is then checked once for all rays passing it.
+ * Tree is stored in preorder and each node knows where its subtree ends, so ray that lost all power is skipped by one jump.
+ * Children keep order in which rays are cast, so first ray that reach a node is known too.
+ */
+class ExplosionRayFan
+{
+public:
+	/// First step of ray skips diagonal big wall `BIGWALLNESW` in center when it is hit from negative side.
+	static constexpr Uint8 SkipNESWNegative = 1;
+	/// First step of ray skips diagonal big wall `BIGWALLNESW` in center when it is hit from positive side.
+	static constexpr Uint8 SkipNESWPositive = 2;
+	/// First step of ray skips diagonal big wall `BIGWALLNWSE` in center when it is hit from negative side.
+	static constexpr Uint8 SkipNWSENegative = 4;
+	/// First step of ray skips diagonal big wall `BIGWALLNWSE` in center when it is hit from positive side.
+	static constexpr Uint8 SkipNWSEPositive = 8;
+
+	/**
+	 * One step of ray, shared by all rays that have same beginning.
+	 */
+	struct Node
+	{
+		/// Position of tile relative to center.
+		Position offset;
+		/// Difference from previous tile of ray.
+		Position step;
+		/// Direction from previous tile of ray, -1 for vertical step or center.
+		Sint8 dir;
+		/// Mask of big walls that first step of ray skips, zero for other steps.
+		Uint8 skip;
+		/// Index of first ray that pass this node, in order of casting.
+		Uint16 ray;
+		/// Number of steps from center.
+		Sint32 depth;
+		/// Index of previous node, -1 for center.
+		Sint32 parent;
+		/// Index of first node after subtree of this node.
+		Sint32 end;
+	};
+
+private:
+	std::vector<Node> _nodes;
+	int _depth = -1;
+
+public:
+	/// Creates empty fan.
+	ExplosionRayFan();
+	/// Cleans up the fan.
+	~ExplosionRayFan();
+
+	/// Makes sure fan cover given number of steps, rebuilds it if needed.
+	void reserve(int depth);
+
+	/// Gets number of nodes in fan.
+	int getNodesCount() const { return (int)_nodes.size(); }
+
+	/**
+	 * Walks all rays together.
+	 * @param func Called for each node with node and its index, returns true if rays can continue past this node.
+	 */
+	template<typename Func>
+	void trace(Func func) const
+	{
+		const int size = (int)_nodes.size();
+		for (int i = 0; i < size; )
+		{
+			if (func(_nodes[i], i))
+			{
+				++i;
+			}
+			else
+			{
+				i = _nodes[i].end;
+			}
+		}
+	}
+};
+
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include "HitChanceGenerator.h"
+#include "Projectile.h"
+#include "LineHelper.h"
+#include "../fmath.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/FileMap.h"
+#include "../Engine/Logger.h"
+#include "../Engine/ParallelFor.h"
+#include "../Engine/RNG.h"
+#include "../Mod/HitChanceTable.h"
+#include "../Mod/MapDataSet.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Shape of target used in simulation.
+ */
+struct TargetModel
+{
+	int size;
+	int height;
+	int loftemps[4];
+};
+
+/// Soldier and tank from vanilla rulesets.
+const TargetModel TargetModels[] =
+{
+	{ 1, 22, { 3, 3, 3, 3 } },
+	{ 2, 16, { 92, 89, 90, 91 } },
+};
+constexpr int TargetModelsCount = sizeof(TargetModels) / sizeof(TargetModels[0]);
+
+/// Height of voxel from where standing soldier shoot.
+constexpr int ShooterHeight = 22 - 4;
+
+/**
+ * Checks if voxel is occupied by target, same test as `TileEngine::voxelCheck` does for units.
+ * @param voxelData LOFT data.
+ * @param model Target shape.
+ * @param tile Position of target.
+ * @param voxel Voxel to check.
+ * @return True if target was hit.
+ */
+bool isTargetVoxel(const std::vector<Uint16>& voxelData, const TargetModel& model, Position tile, Position voxel)
+{
+	if (voxel.x < 0 || voxel.y < 0 || voxel.z <= 0 || voxel.z > model.height)
+	{
+		return false;
+	}
+	const int tx = voxel.x / 16 - tile.x;
+	const int ty = voxel.y / 16 - tile.y;
+	if (tx < 0 || ty < 0 || tx >= model.size || ty >= model.size)
+	{
+		return false;
+	}
+	int part = 0;
+	if (model.size > 1)
+	{
+		constexpr static int parts[] = {1,0,3,2};
+		part = parts[tx + ty*2];
+	}
+	const size_t idx = model.loftemps[part] * 16 + voxel.y % 16;
+	return idx < voxelData.size() && (voxelData[idx] & (1 << (15 - voxel.x % 16)));
+}
+
+/**
+ * Simulates shots at one distance and accuracy.
+ * Target is placed on each tile of quarter ring with given distance in turn,
+ * other quarters are mirror copies as spread is symmetric.
+ * @param voxelData LOFT data.
+ * @param model Target shape.
+ * @param distance Distance to target in tiles.
+ * @param accuracy Accuracy in percents.
+ * @param shots Number of shots.
+ * @param rng Random state of this cell.
+ * @return Chance to hit in percents.
+ */
+int simulateCell(const std::vector<Uint16>& voxelData, const TargetModel& model, int distance, int accuracy, int shots, RNG::RandomState& rng)
+{
+	std::vector<Position> tiles;
+	for (int x = 0; x <= distance; ++x)
+	{
+		for (int y = 0; y <= distance; ++y)
+		{
+			if ((x || y) && (int)Round(std::sqrt((double)(x*x + y*y))) == distance)
+			{
+				tiles.push_back(Position(x, y, 0));
+			}
+		}
+	}
+
+	const Position origin(8, 8, ShooterHeight);
+	const int maxDistance = (distance + model.size + 1) * 16;
+	int hits = 0;
+	for (int i = 0; i < shots; ++i)
+	{
+		const Position tile = tiles[i % tiles.size()];
+		Position target(tile.x * 16 + model.size * 8, tile.y * 16 + model.size * 8, model.height / 2);
+		Projectile::applySpread(rng, origin, &target, accuracy / 100.0, false);
+		Projectile::extendTrajectory(origin, &target, 16 * 1000);
+
+		bool hit = false;
+		auto check = [&](Position voxel)
+		{
+			if (isTargetVoxel(voxelData, model, tile, voxel))
+			{
+				hit = true;
+				return true;
+			}
+			const int dx = voxel.x - origin.x;
+			const int dy = voxel.y - origin.y;
+			// ground or past target
+			return voxel.z <= 0 || dx*dx + dy*dy > maxDistance * maxDistance;
+		};
+		calculateLineHelper(origin, target, check, check);
+		if (hit)
+		{
+			++hits;
+		}
+	}
+	return (int)Round(hits * 100.0 / shots);
+}
+
+}
+
+/**
+ * Loads LOFT data of active mods, simulates all cells of tables on all cores
+ * and writes them in `hitChancesTable` ruleset format.
+ * @return True if file was written.
+ */
+bool HitChanceGenerator::run()
+{
+	const std::string filename = Options::getHitChancesFile();
+	const int shots = Options::getHitChancesShots();
+	Uint64 seed = 0;
+	Options::getBenchmarkSeed(seed);
+
+	std::vector<Uint16> voxelData;
+	try
+	{
+		Options::updateMods();
+		// same rule as in `Mod::loadBattlescapeResources`
+		const auto& terrainContents = FileMap::getVFolderContents("TERRAIN");
+		if (terrainContents.find("loftemps.dat") != terrainContents.end())
+		{
+			MapDataSet::loadLOFTEMPS("TERRAIN/LOFTEMPS.DAT", &voxelData);
+		}
+		else
+		{
+			MapDataSet::loadLOFTEMPS("GEODATA/LOFTEMPS.DAT", &voxelData);
+		}
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		return false;
+	}
+
+	const int rows = HitChanceTable::DistanceRows;
+	const int columns = HitChanceTable::RulesetColumns;
+	const int cellsPerTable = rows * columns;
+	std::vector<int> results(TargetModelsCount * cellsPerTable);
+
+	Log(LOG_INFO) << "Simulating " << shots << " shots for each of " << results.size() << " hit chances...";
+	parallelFor((int)results.size(), getWorkerThreadsCount(0), 1,
+		[&](int begin, int end)
+		{
+			for (int cell = begin; cell < end; ++cell)
+			{
+				const TargetModel& model = TargetModels[cell / cellsPerTable];
+				const int distance = (cell % cellsPerTable) / columns + 1;
+				const int accuracy = (cell % columns) * 2;
+				RNG::RandomState rng(seed + (cell + 1) * 0x9E3779B97F4A7C15ull);
+				results[cell] = simulateCell(voxelData, model, distance, accuracy, shots, rng);
+			}
+		}
+	);
+
+	std::ostringstream out;
+	out << "hitChancesTable:\n";
+	for (int t = 0; t < TargetModelsCount; ++t)
+	{
+		out << "  - unitSize: " << TargetModels[t].size << "\n";
+		out << "    distances:\n";
+		for (int d = 0; d < rows; ++d)
+		{
+			out << "      distance_" << std::setfill('0') << std::setw(2) << d + 1 << ": [";
+			for (int a = 0; a < columns; ++a)
+			{
+				out << (a ? ", " : "") << std::setw(3) << results[t * cellsPerTable + d * columns + a];
+			}
+			out << "]\n";
+		}
+	}
+
+	if (!CrossPlatform::writeFile(filename, out.str()))
+	{
+		Log(LOG_ERROR) << "Failed to write " << filename;
+		return false;
+	}
+	Log(LOG_INFO) << "Hit chances written to " << filename;
+	return true;
+}
+
+}
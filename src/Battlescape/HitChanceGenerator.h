@@ -0,0 +1,41 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Offline generator of `hitChancesTable` ruleset, started by `-hitChances FILE`.
+ * For every unit size, distance and accuracy it fires many shots with the same spread code
+ * that is used in battle at a lone unit standing on open ground, and counts how many of them hit.
+ * Each cell of table use its own random stream, so result depend only on seed and not on number of threads.
+ */
+class HitChanceGenerator
+{
+public:
+	/// Is generator requested on command line?
+	static bool isActive() { return !Options::getHitChancesFile().empty(); }
+	/// Simulates all shots and writes ruleset file, returns false on failure.
+	static bool run();
+};
+
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include "LightSourceCache.h"
+#include "../Savegame/Tile.h"
+
+namespace OpenXcom
+{
+
+static_assert(LightSourceCache::LayerCount == LL_MAX, "Cache need revisions for every light layer");
+
+/**
+ * Creates empty cache.
+ */
+LightSourceCache::LightSourceCache()
+{
+
+}
+
+/**
+ * Cleans up the cache.
+ */
+LightSourceCache::~LightSourceCache()
+{
+
+}
+
+/**
+ * Sets size of map and drops all sources.
+ * @param mapSizeX Width of map in tiles.
+ * @param mapSizeY Length of map in tiles.
+ */
+void LightSourceCache::init(int mapSizeX, int mapSizeY)
+{
+	_regionsX = (mapSizeX + RegionSize - 1) / RegionSize;
+	_regionsY = (mapSizeY + RegionSize - 1) / RegionSize;
+	for (auto& revisions : _regionRevisions)
+	{
+		revisions.assign(_regionsX * _regionsY, 0);
+	}
+	_entries.clear();
+	_order.clear();
+	// empty entries have revision 0 and never match
+	_lastRevision = 1;
+	_flushRevision = 1;
+	_pass = 0;
+	resetStats();
+}
+
+/**
+ * Gets key of source, all its parameters that change lit tiles.
+ * @param center Position of source.
+ * @param power Power of source.
+ * @param layer Light layer.
+ * @return Key.
+ */
+Uint64 LightSourceCache::getKey(Position center, int power, int layer)
+{
+	return ((Uint64)(Uint16)center.x << 48) | ((Uint64)(Uint16)center.y << 32) | ((Uint64)(Uint8)center.z << 24) | ((Uint64)(Uint16)power << 8) | (Uint8)layer;
+}
+
+/**
+ * Gets newest revision of all regions of layer that touch square around center.
+ * @param center Center of square.
+ * @param radius Half of side of square.
+ * @param layer Light layer.
+ * @return Revision.
+ */
+Uint32 LightSourceCache::getRevision(Position center, int radius, int layer) const
+{
+	const int minX = std::max(0, center.x - radius) / RegionSize;
+	const int minY = std::max(0, center.y - radius) / RegionSize;
+	const int maxX = std::min(_regionsX - 1, std::max(0, center.x + radius) / RegionSize);
+	const int maxY = std::min(_regionsY - 1, std::max(0, center.y + radius) / RegionSize);
+
+	const auto& revisions = _regionRevisions[layer];
+	Uint32 revision = _flushRevision;
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			revision = std::max(revision, revisions[y * _regionsX + x]);
+		}
+	}
+	return revision;
+}
+
+/**
+ * Invalidates sources of given layer and all layers above it whose range touch square around center.
+ * Need be called when terrain or light of lower layer change there.
+ * @param fromLayer Lowest layer to invalidate.
+ * @param center Center of square.
+ * @param radius Half of side of square.
+ */
+void LightSourceCache::invalidate(int fromLayer, Position center, int radius)
+{
+	if (fromLayer >= LayerCount || _regionsX == 0 || _regionsY == 0)
+	{
+		return;
+	}
+	const int minX = std::max(0, center.x - radius) / RegionSize;
+	const int minY = std::max(0, center.y - radius) / RegionSize;
+	const int maxX = std::min(_regionsX - 1, std::max(0, center.x + radius) / RegionSize);
+	const int maxY = std::min(_regionsY - 1, std::max(0, center.y + radius) / RegionSize);
+
+	const Uint32 revision = ++_lastRevision;
+	for (int layer = std::max(0, fromLayer); layer < LayerCount; ++layer)
+	{
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				_regionRevisions[layer][y * _regionsX + x] = revision;
+			}
+		}
+	}
+}
+
+/**
+ * Invalidates all sources.
+ */
+void LightSourceCache::flush()
+{
+	_flushRevision = ++_lastRevision;
+}
+
+/**
+ * Marks entry as most recently used and used by current pass.
+ * @param entry Entry of source.
+ */
+void LightSourceCache::touch(Entry& entry)
+{
+	_order.splice(_order.begin(), _order, entry.order);
+	entry.pass = _pass;
+}
+
+/**
+ * Drops least recently used entries until there is place for new one,
+ * stops at first entry used by current pass, as all newer ones are used by it too.
+ */
+void LightSourceCache::evict()
+{
+	while (_entries.size() >= MaxSources)
+	{
+		auto it = _entries.find(_order.back());
+		if (it->second.pass == _pass)
+		{
+			break;
+		}
+		_order.pop_back();
+		_entries.erase(it);
+	}
+}
+
+/**
+ * Finds tiles lit by source.
+ * @param center Position of source.
+ * @param power Power of source, it light tiles up to `power - 1` tiles away.
+ * @param layer Light layer.
+ * @param area Part of map where lit tiles are needed.
+ * @return Tiles lit by source or null if source need be traced again.
+ */
+const std::vector<LightContribution>* LightSourceCache::find(Position center, int power, int layer, Area area)
+{
+	auto it = _entries.find(getKey(center, power, layer));
+	if (it != _entries.end() && it->second.revision == getRevision(center, power - 1, layer) && Area::intersection(it->second.area, area) == area)
+	{
+		touch(it->second);
+		++_hits;
+		return &it->second.tiles;
+	}
+	++_misses;
+	return nullptr;
+}
+
+/**
+ * Gets empty buffer where caller store tiles lit by source.
+ * @param center Position of source.
+ * @param power Power of source.
+ * @param layer Light layer.
+ * @param area Part of map that caller traces.
+ * @return Buffer for lit tiles.
+ */
+std::vector<LightContribution>& LightSourceCache::store(Position center, int power, int layer, Area area)
+{
+	const Uint64 key = getKey(center, power, layer);
+	auto it = _entries.find(key);
+	if (it == _entries.end())
+	{
+		evict();
+		it = _entries.emplace(key, Entry{}).first;
+		_order.push_front(key);
+		it->second.order = _order.begin();
+	}
+	Entry& entry = it->second;
+	touch(entry);
+	entry.revision = getRevision(center, power - 1, layer);
+	entry.area = area;
+	entry.tiles.clear();
+	return entry.tiles;
+}
+
+}
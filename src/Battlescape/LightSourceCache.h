@@ -0,0 +1,136 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <SDL_types.h>
+#include "Position.h"
+#include "../Engine/GraphSubset.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Light that one source gives to one tile.
+ * Enhanced lighting trace two rays to tile, each ray is stopped when its light drop below light tile already has.
+ * Rays are stored as they were traced against lower layers only, stopping them is left for the time
+ * when light is added, so result is the same as tracing against light tile has at that moment.
+ */
+struct LightContribution
+{
+	Position pos;
+	/// Light of first ray, 0 if it was stopped.
+	Uint8 lightA;
+	/// Light of second ray, 0 if it was stopped.
+	Uint8 lightB;
+
+	/**
+	 * Gets light that reach tile.
+	 * @param targetLight Light tile already has, rays weaker than it are stopped.
+	 * @return Light of source, only useful when bigger than `targetLight`.
+	 */
+	int getLight(int targetLight) const
+	{
+		return ((lightA >= targetLight ? lightA : 0) + (lightB >= targetLight ? lightB : 0)) / 2;
+	}
+};
+
+/**
+ * Cache of tiles lit by single light source, so sources that did not change are not traced again
+ * when lighting of area is recalculated, e.g. after every step of unit.
+ * Light of source depends on terrain and lower light layers in its range,
+ * map is divided into columns with revision for each layer, bumped when anything there change.
+ * Least recently used sources are dropped, but never ones used by current lighting pass,
+ * so cache grows to number of sources lit at once when there are more than `MaxSources`.
+ */
+class LightSourceCache
+{
+public:
+	/// Size in tiles of one side of region column.
+	static constexpr int RegionSize = 8;
+	/// Number of light layers.
+	static constexpr int LayerCount = 4;
+	/// Number of sources kept in cache when they are not used by current pass.
+	static constexpr size_t MaxSources = 1024;
+	/// Part of map traced for source.
+	using Area = AreaSubset<Position, Sint16>;
+
+private:
+	/**
+	 * Helper struct with lit tiles of one source.
+	 */
+	struct Entry
+	{
+		Uint32 revision = 0;
+		Uint32 pass = 0;
+		Area area;
+		std::list<Uint64>::iterator order;
+		std::vector<LightContribution> tiles;
+	};
+
+	std::unordered_map<Uint64, Entry> _entries;
+	std::list<Uint64> _order;
+	std::vector<Uint32> _regionRevisions[LayerCount];
+	int _regionsX = 0, _regionsY = 0;
+	Uint32 _lastRevision = 0;
+	Uint32 _flushRevision = 0;
+	Uint32 _pass = 0;
+	Uint64 _hits = 0, _misses = 0;
+
+	/// Gets key of source.
+	static Uint64 getKey(Position center, int power, int layer);
+	/// Gets newest revision of all regions in range of source.
+	Uint32 getRevision(Position center, int radius, int layer) const;
+	/// Marks entry as most recently used.
+	void touch(Entry& entry);
+	/// Drops least recently used entries over limit.
+	void evict();
+
+public:
+	/// Creates empty cache.
+	LightSourceCache();
+	/// Cleans up the cache.
+	~LightSourceCache();
+
+	/// Sets size of map.
+	void init(int mapSizeX, int mapSizeY);
+	/// Invalidates sources of given layer and above that reach area.
+	void invalidate(int fromLayer, Position center, int radius);
+	/// Invalidates all sources.
+	void flush();
+	/// Starts new lighting pass, sources used by it are not dropped.
+	void beginPass() { ++_pass; }
+
+	/// Finds tiles lit by source in area, if nothing changed in its range.
+	const std::vector<LightContribution>* find(Position center, int power, int layer, Area area);
+	/// Gets empty buffer for tiles lit by source in area, valid until something changes in its range.
+	std::vector<LightContribution>& store(Position center, int power, int layer, Area area);
+
+	/// Gets number of sources in cache.
+	size_t getSize() const { return _entries.size(); }
+	/// Gets number of successful finds.
+	Uint64 getHits() const { return _hits; }
+	/// Gets number of failed finds.
+	Uint64 getMisses() const { return _misses; }
+	/// Resets statistic of finds.
+	void resetStats() { _hits = 0; _misses = 0; }
+};
+
+}
@@ -19,9 +19,11 @@
 #include "Map.h"
 #include "Camera.h"
 #include "UnitSprite.h"
+#include "UnitSpriteCache.h"
 #include "ItemSprite.h"
 #include "Pathfinding.h"
 #include "TileEngine.h"
+#include "TargetingPreview.h"
 #include "Projectile.h"
 #include "Explosion.h"
 #include "BattlescapeState.h"
@@ -52,6 +54,7 @@
 #include "../Interface/NumberText.h"
 #include "../Interface/Text.h"
 #include "../fmath.h"
+#include <cstring>
 
 
 /*
@@ -180,7 +183,10 @@ Map::Map(Game *game, int width, int height, int x, int y, int visibleMapHeight)
 	_cacheIsCtrlPressed = false;
 	_cacheCursorPosition = TileEngine::invalid;
 	_cacheHasLOS = -1;
-	_cacheAccuracy = -1;
+	_targetingPreview = new TargetingPreview(_save, _game->getMod());
+	_unitSpriteCache = new UnitSpriteCache();
+	_animateBusy = true;
+	_partialRedraw = false;
 
 	_thisTileVisible = false;
 	_nightVisionOn = false;
@@ -254,6 +260,8 @@ Map::~Map()
 	delete _message;
 	delete _camera;
 	delete _txtAccuracy;
+	delete _targetingPreview;
+	delete _unitSpriteCache;
 }
 
 /**
@@ -309,24 +317,50 @@ void Map::think()
  */
 void Map::draw()
 {
-	if (!_redraw)
+	if (!_redraw && _dirtyRegion.empty())
 	{
 		return;
 	}
 
+	// when only animation tick changed something, redraw only tiles around changed areas
+	const DrawState drawState = getDrawState();
+	_partialRedraw = !_redraw && !_dirtyRegion.isFull() && drawState == _lastDrawState && canRedrawPartially();
+	_lastDrawState = drawState;
+
 	// normally we'd call for a Surface::draw();
 	// but we don't want to clear the background with colour 0, which is transparent (aka black)
 	// we use colour 15 because that actually corresponds to the colour we DO want in all variations of the xcom and tftd palettes.
 	// Note: un-hardcoded the color from 15 to ruleset value, default 15
 	_redraw = false;
-	ShaderDrawFunc(
-		[](Uint8& dest, Uint8 color)
+	if (_partialRedraw)
+	{
+		const Uint8 *buffer = getBuffer();
+		_dirtyBackup.assign(buffer, buffer + getPitch() * getHeight());
+		for (const auto& area : _dirtyRegion.getAreas())
 		{
-			dest = color;
-		},
-		ShaderSurface(this),
-		ShaderScalar<Uint8>(Palette::blockOffset(0) + _bgColor)
-	);
+			ShaderMove<Uint8> areaDest(this);
+			areaDest.setDomain(area);
+			ShaderDrawFunc(
+				[](Uint8& dest, Uint8 color)
+				{
+					dest = color;
+				},
+				areaDest,
+				ShaderScalar<Uint8>(Palette::blockOffset(0) + _bgColor)
+			);
+		}
+	}
+	else
+	{
+		ShaderDrawFunc(
+			[](Uint8& dest, Uint8 color)
+			{
+				dest = color;
+			},
+			ShaderSurface(this),
+			ShaderScalar<Uint8>(Palette::blockOffset(0) + _bgColor)
+		);
+	}
 
 	Tile *t;
 
@@ -366,6 +400,157 @@ void Map::draw()
 	{
 		_message->blit(this->getSurface());
 	}
+
+	if (_partialRedraw)
+	{
+		// keep new pixels only in changed areas, rest of surface get back its old content
+		Uint8 *buffer = getBuffer();
+		const int pitch = getPitch();
+		for (const auto& area : _dirtyRegion.getAreas())
+		{
+			for (int y = area.beg_y; y < area.end_y; ++y)
+			{
+				memcpy(&_dirtyBackup[y * pitch + area.beg_x], buffer + y * pitch + area.beg_x, area.size_x());
+			}
+		}
+		memcpy(buffer, _dirtyBackup.data(), _dirtyBackup.size());
+		_partialRedraw = false;
+	}
+	_dirtyRegion.clear();
+}
+
+/**
+ * Blits the map, areas changed by animation are drawn before it.
+ * @param surface Pointer to surface to blit onto.
+ */
+void Map::blit(SDL_Surface *surface)
+{
+	if (!_dirtyRegion.empty() && getVisible())
+	{
+		draw();
+	}
+	InteractiveSurface::blit(surface);
+}
+
+/**
+ * Compares all fields of state.
+ * @param other Other state.
+ * @return True if map looks same in both states.
+ */
+bool Map::DrawState::operator==(const DrawState& other) const
+{
+	return cameraOffset == other.cameraOffset && selectedUnit == other.selectedUnit
+		&& selectorX == other.selectorX && selectorY == other.selectorY
+		&& cursorType == other.cursorType && cursorSize == other.cursorSize
+		&& fadeShade == other.fadeShade && nvColor == other.nvColor && debugVisionMode == other.debugVisionMode && globalShade == other.globalShade
+		&& width == other.width && height == other.height && visibleMapHeight == other.visibleMapHeight
+		&& viewRevision == other.viewRevision && terrainRevision == other.terrainRevision
+		&& showAllLayers == other.showAllLayers && showSingleLayer == other.showSingleLayer
+		&& altPressed == other.altPressed && ctrlPressed == other.ctrlPressed;
+}
+
+/**
+ * Gets global state that change how whole map looks, any change in it require redrawing all of map.
+ * @return Current state.
+ */
+Map::DrawState Map::getDrawState() const
+{
+	DrawState state;
+	state.cameraOffset = _camera->getMapOffset();
+	state.selectedUnit = _save->getSelectedUnit();
+	state.selectorX = _selectorX;
+	state.selectorY = _selectorY;
+	state.cursorType = _cursorType;
+	state.cursorSize = _cursorSize;
+	state.fadeShade = _fadeShade;
+	state.nvColor = _nvColor;
+	state.debugVisionMode = _debugVisionMode;
+	state.globalShade = _save->getGlobalShade();
+	state.width = getWidth();
+	state.height = getHeight();
+	state.visibleMapHeight = _visibleMapHeight;
+	state.viewRevision = _save->getTileEngine()->getViewRevision();
+	state.terrainRevision = _save->getTileEngine()->getTerrainRevision();
+	state.showAllLayers = _camera->getShowAllLayers();
+	state.showSingleLayer = _camera->getShowSingleLayer();
+	state.altPressed = _game->isAltPressed(true);
+	state.ctrlPressed = _game->isCtrlPressed(true);
+	return state;
+}
+
+/**
+ * Checks if there is anything on map that is animated or moving in way that can't be tracked by tiles.
+ * @return True if only areas changed by animation tick can be drawn.
+ */
+bool Map::canRedrawPartially() const
+{
+	if (_save->getSide() != FACTION_PLAYER || _save->getDebugMode() || _projectile || !_explosions.empty()
+		|| _unitDying || _flashScreen || _smoothingEngaged || _showObstacles || _isAltPressed
+		|| !_waypoints.empty() || _save->getPathfinding()->isPathPreviewed())
+	{
+		return false;
+	}
+	for (const auto& tilePar : _vaporParticles)
+	{
+		if (!tilePar.empty())
+		{
+			return false;
+		}
+	}
+	for (const auto& tilePar : _vaporParticlesInit)
+	{
+		if (!tilePar.empty())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Marks area around tile as need be drawn again, it covers everything that can be drawn on this tile.
+ * @param region Region where area is added.
+ * @param pos Position of tile.
+ * @param offset Screen offset of things drawn on tile, e.g. walking unit.
+ * @param raise How many more pixels above usual area are drawn.
+ */
+void Map::addDirtyTile(DirtyRegion &region, Position pos, Position offset, int raise) const
+{
+	if (pos.z > _camera->getViewLevel() && !_camera->getShowAllLayers())
+	{
+		return;
+	}
+	Position screenPosition;
+	_camera->convertMapToScreen(pos, &screenPosition);
+	screenPosition += _camera->getMapOffset() + offset;
+	GraphSubset area = GraphSubset(
+		std::make_pair(screenPosition.x - _spriteWidth / 2, screenPosition.x + _spriteWidth * 3 / 2),
+		std::make_pair(screenPosition.y - _spriteHeight - raise, screenPosition.y + _spriteHeight * 5 / 4)
+	);
+	region.add(GraphSubset::intersection(area, GraphSubset(getWidth(), getHeight())));
+}
+
+/**
+ * Marks area covered by unit as need be drawn again, same as `drawUnit` and selection arrow
+ * it is moved by walking offset and terrain level, and reach up to facing indicator and arrow above head of unit.
+ * @param region Region where area is added.
+ * @param unit Unit.
+ */
+void Map::addDirtyUnit(DirtyRegion &region, const BattleUnit *unit) const
+{
+	const Position offset = calculateWalkingOffset(unit).ScreenOffset;
+	// arrow is lifted by height and float height of unit and by kneeling, facing indicator by height
+	const int arrowTop = Position::TileZ - (unit->getHeight() + unit->getFloatHeight()) - 2 - _arrow->getHeight();
+	const int indicatorTop = -30 + (22 - unit->getHeight());
+	const int raise = std::max(0, -_spriteHeight - std::min(arrowTop, indicatorTop));
+	const int size = unit->getArmor()->getSize();
+	for (int x = 0; x < size; ++x)
+	{
+		for (int y = 0; y < size; ++y)
+		{
+			addDirtyTile(region, unit->getPosition() + Position(x, y, 0), offset, raise);
+		}
+	}
 }
 
 void Map::refreshAIProgress(int progress)
@@ -463,6 +648,7 @@ static const int TXT_YELLOW	= Palette::blockOffset(Pathfinding::yellow - 1) - 1;
 static const int TXT_RED	= Palette::blockOffset(Pathfinding::red - 1) - 1;
 static const int TXT_BROWN	= Palette::blockOffset(Pathfinding::brown - 1) - 1;
 static const int TXT_WHITE	= Palette::blockOffset(Pathfinding::white - 1) - 1;
+static const int TargetingPreviewColors[] = { TXT_YELLOW, TXT_GREEN, TXT_WHITE, TXT_BROWN }; // indexed by TargetingPreviewRating
 
 static const int ArrowBobOffsets[8] = {0,1,2,1,0,1,2,1};
 
@@ -744,9 +930,6 @@ void Map::drawUnit(UnitSprite &unitSprite, Tile *unitTile, Tile *currTile, Posit
  */
 void Map::drawTerrain(Surface *surface)
 {
-	if (Options::oxceFOW)
-		_save->updateVisibleTiles();
-
 	_isAltPressed = _game->isAltPressed(true);
 	_isCtrlPressed = _game->isCtrlPressed(true);
 	int frameNumber = 0;
@@ -761,7 +944,7 @@ void Map::drawTerrain(Surface *surface)
 	BattleUnit *movingUnit = _save->getTileEngine()->getMovingUnit();
 	int tileShade, tileColor, obstacleShade;
 	UnitSprite unitSprite(surface, _game->getMod(), _save, _animFrame, _save->getDepth() != 0,
-		_isTFTD ? ArrowColorsTFTD[1] : ArrowColorsUFO[1], _isTFTD ? ArrowColorsTFTD[2] : ArrowColorsUFO[2]);
+		_isTFTD ? ArrowColorsTFTD[1] : ArrowColorsUFO[1], _isTFTD ? ArrowColorsTFTD[2] : ArrowColorsUFO[2], _unitSpriteCache);
 	ItemSprite itemSprite(surface, _game->getMod(), _save, _animFrame);
 	int colorBeforeFoW = _nvColor;
 
@@ -905,11 +1088,6 @@ void Map::drawTerrain(Surface *surface)
 	if (movingUnit)
 	{
 		movingUnitPosition = movingUnit->getPosition();
-
-		//Update FOW if player unit moving
-		if (Options::oxceFOW)
-			if (movingUnit->getFaction() == FACTION_PLAYER)
-				_save->updateVisibleTiles();
 	}
 
 	surface->lock();
@@ -926,9 +1104,12 @@ void Map::drawTerrain(Surface *surface)
 				_camera->convertMapToScreen(mapPosition, &screenPosition);
 				screenPosition += cameraPos;
 
-				// only render cells that are inside the surface
+				// only render cells that are inside the surface, and when only part of it is redrawn, cells that can reach it
 				if (screenPosition.x > -_spriteWidth && screenPosition.x < surface->getWidth() + _spriteWidth &&
-					screenPosition.y > -_spriteHeight && screenPosition.y < surface->getHeight() + _spriteHeight )
+					screenPosition.y > -_spriteHeight && screenPosition.y < surface->getHeight() + _spriteHeight &&
+					(!_partialRedraw || _dirtyRegion.intersects(GraphSubset(
+						std::make_pair(screenPosition.x - _spriteWidth, screenPosition.x + _spriteWidth * 2),
+						std::make_pair(screenPosition.y - _spriteHeight * 2, screenPosition.y + _spriteHeight * 2)))))
 				{
 					bool isUnitMovingNearby = movingUnit && positionInRangeXY(movingUnitPosition, mapPosition, 2);
 
@@ -945,7 +1126,7 @@ void Map::drawTerrain(Surface *surface)
 								_thisTileVisible = false;
 						}
 						else
-							_thisTileVisible = _save->isTileVisible(tile);
+							_thisTileVisible = tile->isVisibleToPlayer(); // counted by FOV code when units see or stop seeing tile
 						if (_thisTileVisible)
 						{
 							tileShade = reShade(tile);
@@ -1395,7 +1576,6 @@ void Map::drawTerrain(Surface *surface)
 							tmpSurface = _game->getMod()->getSurfaceSet("CURSOR.PCK")->getFrame(frameNumber);
 							Surface::blitRaw(surface, tmpSurface, screenPosition.x, screenPosition.y, 0);
 
-							bool disableRA = false;
 							int targetSize = 1;
 							if (unit && unit->getVisible()) targetSize = unit->getArmor()->getSize();
 
@@ -1486,7 +1666,7 @@ void Map::drawTerrain(Surface *surface)
 										// replace accuracy number by chance-to-hit
 										if (Options::useChanceToHit)
 										{
-											accuracy = Projectile::getHitChance(distance, accuracy, _game->getMod()->getHitChancesTable(targetSize));
+											accuracy = _game->getMod()->getHitChance(targetSize, distance, accuracy);
 										}
 
 										ss << accuracy << "%";
@@ -1494,207 +1674,26 @@ void Map::drawTerrain(Surface *surface)
 								}
 								else // Realistic Accuracy
 								{
-									const bool isCtrlPressed = _game->isCtrlPressed(true);
-									const bool isKneeled = action->actor->isKneeled();
-									int accuracyInteger = 0;
-									double accuracy = 0.0;
-									bool targetSelf = false;
-									double maxExposure = 0.0;
-									double distanceFloat = 0.0;
-									int maxVoxels = 0;
-
-									if (Position(itX, itY, itZ) == _cacheCursorPosition && isCtrlPressed == _cacheIsCtrlPressed && isKneeled == _cacheIsKneeled && _cacheAccuracy != -1 && _cacheAccuracyTextColor != -1)
-									{
-										accuracyInteger = _cacheAccuracy;
-										_txtAccuracy->setColor(_cacheAccuracyTextColor);
-										targetSelf = _cacheTargetSelf;
-									}
-									else
-									{
-										BattleUnit* shooterUnit = action->actor;
-										const Mod::AccuracyModConfig *AccuracyMod = _game->getMod()->getAccuracyModConfig();
-										int distanceVoxels = 0;
-
-										auto* ammo = attack.damage_item;
-										const RuleItem *ammoRule = (ammo != nullptr) ? ammo->getRules() : nullptr;
-
-										bool isShotgun = ammoRule && ammoRule->getShotgunPellets() != 0 && ammoRule->getDamageType()->isDirect();
-										bool isArcingShot = action->weapon->getArcingShot(action->type);
-										bool isSpray = action->sprayTargeting;
-										disableRA = isShotgun || isArcingShot || isSpray;
-
-										if (unit && unit == shooterUnit)
-										{
-											targetSelf = true;
-										}
-										else
-										{
-											Tile *targetTile = nullptr;
-											std::vector<Position> exposedVoxels;
-
-											if (unit && unit->getVisible()) // Targeting a unit
-											{
-												targetSize = unit->getArmor()->getSize();
-												targetTile = unit->getTile();
-												exposedVoxels.reserve((1 + BattleUnit::BIG_MAX_RADIUS * 2) * TileEngine::voxelTileSize.z / 2);
-
-												// This is needed inside getOriginVoxel() to get direction
-												action->target = unit->getPosition();
+									const TargetingPreviewResult &preview = _targetingPreview->get(action, Position(itX, itY, itZ), unit, tile);
 
-												Position selectedOrigin = TileEngine::invalid;
-												std::vector<BattleActionOrigin> originTypes;
-												originTypes.push_back(BattleActionOrigin::CENTRE);
-												if (Options::oxceEnableOffCentreShooting)
-												{
-													originTypes.push_back(BattleActionOrigin::LEFT);
-													originTypes.push_back(BattleActionOrigin::RIGHT);
-												}
-
-												// Find shooting point with best target's exposure
-												for (const auto &relPos : originTypes)
-												{
-													exposedVoxels.clear();
-													action->relativeOrigin = relPos;
-													Position origin = _save->getTileEngine()->getOriginVoxel(*action, shooterUnit->getTile());
-													double exposure = _save->getTileEngine()->checkVoxelExposure(&origin, targetTile, shooterUnit, false, &exposedVoxels, nullptr, false);
-
-													// Save default values for center origin
-													// Overwrite if better results are found for shifted origins
-													if (relPos == BattleActionOrigin::CENTRE || (int)exposedVoxels.size() > maxVoxels)
-													{
-														selectedOrigin = origin;
-														maxVoxels = exposedVoxels.size();
-														maxExposure = exposure;
-													}
-												}
-												action->relativeOrigin = BattleActionOrigin::CENTRE; // Reset to default! It's used elsewhere
-												distanceVoxels = unit->distance3dToPositionPrecise(selectedOrigin) - shooterUnit->getRadiusVoxels();
-											}
-											else if (shooterUnit->getTile()) // Targeting an empty tile
-											{
-												action->relativeOrigin = BattleActionOrigin::CENTRE;
-												action->target = Position{itX, itY, itZ};
-												Position targetPos = action->target.toVoxel();
-												Position origin = _save->getTileEngine()->getOriginVoxel(*action, shooterUnit->getTile());
-												targetTile = _save->getTile(action->target);
-												bool isPlayer = (shooterUnit->getFaction() == FACTION_PLAYER);
-												targetPos = _save->getTileEngine()->adjustTargetVoxelFromTileType(&origin, targetTile, shooterUnit, isPlayer);
-												distanceVoxels = Position::distance(origin, targetPos) - shooterUnit->getRadiusVoxels();
-											}
-
-											accuracy = static_cast<double>(BattleUnit::getFiringAccuracy(attack, _game->getMod()));
-											distanceFloat = (double)distanceVoxels / Position::TileXY;
-
-											int upperLimit, lowerLimit;
-											int dropoff = weapon->calculateLimits(upperLimit, lowerLimit, _save->getDepth(), action->type);
-
-											_txtAccuracy->setColor(TXT_YELLOW);
-											if (distanceFloat > upperLimit)
-											{
-												accuracy -= (distanceFloat - upperLimit) * dropoff;
-											}
-											else if (distanceFloat < lowerLimit)
-											{
-												accuracy -= (lowerLimit - distanceFloat) * dropoff;
-											}
-											else
-											{
-												_txtAccuracy->setColor(TXT_GREEN);
-											}
-
-											int noLOSAccuracyPenalty = weapon->getNoLOSAccuracyPenalty(_game->getMod());
-											if (noLOSAccuracyPenalty != -1)
-											{
-												bool hasLOS = false;
-												if (Position(itX, itY, itZ) == _cacheCursorPosition && isCtrlPressed == _cacheIsCtrlPressed && _cacheHasLOS != -1)
-												{
-													hasLOS = (_cacheHasLOS == 1);
-												}
-												else
-												{
-													if (unit && (unit->getVisible() || _save->getDebugMode()))
-													{
-														hasLOS = _save->getTileEngine()->visible(action->actor, tile);
-													}
-													else
-													{
-														hasLOS = _save->getTileEngine()->isTileInLOS(action, tile, false);
-													}
-													_cacheHasLOS = hasLOS ? 1 : 0;
-												}
-
-												if (!hasLOS)
-												{
-													accuracy *= (double)noLOSAccuracyPenalty / 100.0;
-													_txtAccuracy->setColor(TXT_YELLOW);
-												}
-											}
-
-											int snipingBonus = (round(accuracy) > 100 ? round((accuracy - 100) / 2) : 0);
-											bool isSniperShot = (snipingBonus > 0  && !disableRA);
-
-											bool coverHasEffect = AccuracyMod->coverEfficiency[(int)Options::battleRealisticCoverEfficiency];
-											if (unit && maxVoxels > 0 && coverHasEffect && !disableRA)
-											{
-												// Apply the exposure
-												double coverEfficiencyCoeff = AccuracyMod->coverEfficiency[(int)Options::battleRealisticCoverEfficiency] / 100.0;
-												accuracy = accuracy * coverEfficiencyCoeff * maxExposure + accuracy * (1.0 - coverEfficiencyCoeff);
-											}
-
-											accuracyInteger = round(accuracy);
-											distance = round(distanceFloat);
-											if (distance < 1) distance = 1;
-
-											accuracyInteger = Projectile::getHitChance(distance, accuracyInteger, _game->getMod()->getHitChancesTable(targetSize));
-
-											if (Options::battleRealisticImprovedAimed && isSniperShot)
-											{
-												accuracyInteger += snipingBonus;
-											}
-
-											int distanceSq = action->actor->distance3dToPositionSq(Position(itX, itY, itZ));
-											bool outOfRange = weapon->isOutOfRange(distanceSq);
-
-											if (isSniperShot)
-											{
-												_txtAccuracy->setColor(TXT_WHITE);
-											}
-
-											if (outOfRange)
-											{
-												accuracyInteger = 0;
-												_txtAccuracy->setColor(TXT_BROWN);
-											}
-											else if (unit && (unit->getVisible() || _save->getDebugMode()) && maxVoxels == 0)
-											{
-												_txtAccuracy->setColor(TXT_BROWN);
-											}
-										}
-
-										_cacheCursorPosition = Position(itX, itY, itZ);
-										_cacheAccuracyTextColor = _txtAccuracy->getColor();
-										_cacheAccuracy = accuracyInteger;
-										_cacheIsKneeled = isKneeled;
-										_cacheTargetSelf = targetSelf;
-									}
-
-									if (isCtrlPressed && maxVoxels > 0)
+									if (_game->isCtrlPressed(true) && preview.maxVoxels > 0)
 									{
 										int currentColor = TXT_RED;
-										if (disableRA) currentColor = TXT_BROWN;
-										else if (maxExposure > 0.65) currentColor = TXT_GREEN;
-										else if (maxExposure > 0.35) currentColor = TXT_YELLOW;
+										if (preview.disableRA) currentColor = TXT_BROWN;
+										else if (preview.maxExposure > 0.65) currentColor = TXT_GREEN;
+										else if (preview.maxExposure > 0.35) currentColor = TXT_YELLOW;
 										_txtAccuracy->setColor(currentColor);
-										ss << "> " << std::round(maxExposure * 100) << "% <";
+										ss << "> " << std::round(preview.maxExposure * 100) << "% <";
 									}
-									else if (targetSelf)
+									else if (preview.targetSelf)
 									{
 										ss.str("");
 										ss.clear();
 									}
 									else
 									{
-										ss << accuracyInteger << "%";
+										_txtAccuracy->setColor(TargetingPreviewColors[preview.rating]);
+										ss << preview.accuracy << "%";
 									}
 								}
 
@@ -2308,10 +2307,18 @@ void Map::animate(bool redraw)
 		}
 	}
 
+	// areas that change in this tick, when battle is idle
+	DirtyRegion animated;
+
 	// animate tiles
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
-		_save->getTile(i)->animate();
+		Tile *tile = _save->getTile(i);
+		const bool spriteChanged = tile->animate();
+		if (redraw && (spriteChanged || tile->getSmoke() || tile->getFire() || !tile->getInventory()->empty()))
+		{
+			addDirtyTile(animated, tile->getPosition());
+		}
 	}
 
 	// animate vapor
@@ -2408,9 +2415,54 @@ void Map::animate(bool redraw)
 		}
 
 		bu->breathe();
+
+		// recolor scripts can use animation frame, every unit can change
+		if (redraw && !bu->isOut())
+		{
+			addDirtyUnit(animated, bu);
+		}
 	}
 
-	if (redraw) _redraw = true;
+	if (redraw && _cursorType != CT_NONE)
+	{
+		for (int z = 0; z < _save->getMapSizeZ(); ++z)
+		{
+			for (int x = 0; x < _cursorSize; ++x)
+			{
+				for (int y = 0; y < _cursorSize; ++y)
+				{
+					addDirtyTile(animated, Position(_selectorX + x, _selectorY + y, z));
+				}
+			}
+		}
+	}
+
+	// units mostly change while battle is busy, so their composed sprites are dropped during it and once after it,
+	// changes made outside of it (popup states, end of turn) call invalidateUnitSprites
+	if (!redraw || _animateBusy)
+	{
+		_unitSpriteCache->clear();
+	}
+
+	if (redraw)
+	{
+		// areas of last tick are added too, they cover places that units or cursor left
+		if (!_animateBusy && canRedrawPartially() && getDrawState() == _lastDrawState)
+		{
+			_dirtyRegion.add(animated);
+			_dirtyRegion.add(_animatedRegion);
+			if (_dirtyRegion.isFull() || _dirtyRegion.getSize() > getWidth() * getHeight() / 2)
+			{
+				_redraw = true;
+			}
+		}
+		else
+		{
+			_redraw = true;
+		}
+		_animatedRegion = animated;
+	}
+	_animateBusy = !redraw;
 }
 
 /**
@@ -2561,6 +2613,7 @@ void Map::setCursorType(CursorType type, int size)
 	_cacheIsCtrlPressed = false;
 	_cacheCursorPosition = TileEngine::invalid;
 	_cacheHasLOS = -1;
+	_targetingPreview->invalidate();
 
 	_cursorType = type;
 	if (_cursorType == CT_NORMAL)
@@ -2894,4 +2947,14 @@ void Map::disableObstacles(void)
 	}
 }
 
+/**
+ * Drops all composed unit sprites.
+ * Need be called when units change while battle is not busy, e.g. by popup states or at end of turn,
+ * as scripts that recolor them can read any state of unit.
+ */
+void Map::invalidateUnitSprites()
+{
+	_unitSpriteCache->clear();
+}
+
 }
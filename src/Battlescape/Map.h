@@ -20,6 +20,7 @@
 #include "../Engine/InteractiveSurface.h"
 #include "../Engine/Options.h"
 #include "../Engine/Collections.h"
+#include "../Engine/DirtyRegion.h"
 #include "../Mod/MapData.h"
 #include "Position.h"
 #include "Particle.h"
@@ -40,6 +41,8 @@ class Timer;
 class Text;
 class Tile;
 class UnitSprite;
+class TargetingPreview;
+class UnitSpriteCache;
 
 enum CursorType { CT_NONE, CT_NORMAL, CT_AIM, CT_PSI, CT_WAYPOINT, CT_THROW };
 enum TilePart : int;
@@ -60,6 +63,24 @@ struct UnitWalkingOffset
 class Map : public InteractiveSurface
 {
 private:
+	/**
+	 * Helper struct with global state that change how whole map looks.
+	 */
+	struct DrawState
+	{
+		Position cameraOffset;
+		const BattleUnit *selectedUnit = nullptr;
+		int selectorX = 0, selectorY = 0;
+		CursorType cursorType = CT_NONE;
+		int cursorSize = 0;
+		int fadeShade = 0, nvColor = 0, debugVisionMode = 0, globalShade = 0;
+		int width = 0, height = 0, visibleMapHeight = 0;
+		Uint32 viewRevision = 0, terrainRevision = 0;
+		bool showAllLayers = false, showSingleLayer = false, altPressed = false, ctrlPressed = false;
+
+		bool operator==(const DrawState& other) const;
+	};
+
 	bool _thisTileVisible;
 	static const int SCROLL_INTERVAL = 15;
 	static const int FADE_INTERVAL = 23;
@@ -85,12 +106,15 @@ private:
 	int _cursorSize;
 	int _cacheActiveWeaponUfopediaArticleUnlocked; // -1 = unknown, 0 = locked, 1 = unlocked
 	bool _cacheIsCtrlPressed;
-	bool _cacheIsKneeled = false;
-	bool _cacheTargetSelf = false;
 	Position _cacheCursorPosition;
 	int _cacheHasLOS; // -1 = unknown, 0 = no LOS, 1 = has LOS
-	int _cacheAccuracy; // -1 = unknown
-	int _cacheAccuracyTextColor = -1;
+	TargetingPreview *_targetingPreview;
+	UnitSpriteCache *_unitSpriteCache;
+	bool _animateBusy;
+	DirtyRegion _dirtyRegion, _animatedRegion;
+	DrawState _lastDrawState;
+	bool _partialRedraw;
+	std::vector<Uint8> _dirtyBackup;
 	int _animFrame;
 	Projectile *_projectile;
 	bool _followProjectile;
@@ -111,6 +135,14 @@ private:
 
 	void drawUnit(UnitSprite &unitSprite, Tile *unitTile, Tile *currTile, Position tileScreenPosition, bool topLayer, BattleUnit* movingUnit = nullptr);
 	void drawTerrain(Surface *surface);
+	/// Gets global state that change how map looks.
+	DrawState getDrawState() const;
+	/// Checks if nothing on map is animated in way that require redrawing all of it.
+	bool canRedrawPartially() const;
+	/// Marks area around tile as need be drawn again.
+	void addDirtyTile(DirtyRegion &region, Position pos, Position offset = Position(0, 0, 0), int raise = 0) const;
+	/// Marks area covered by unit and its markers as need be drawn again.
+	void addDirtyUnit(DirtyRegion &region, const BattleUnit *unit) const;
 	int getTerrainLevel(const Position& pos, int size) const;
 	int getWallShade(TilePart part, Tile* tileFrot);
 	int _iconHeight, _iconWidth, _messageColor;
@@ -129,6 +161,8 @@ public:
 	void think() override;
 	/// Draws the surface.
 	void draw() override;
+	/// Blits the surface, draws areas that changed first.
+	void blit(SDL_Surface *surface) override;
 	void refreshAIProgress(int progress);
 	/// Sets the palette.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256) override;
@@ -222,6 +256,8 @@ public:
 	void enableObstacles();
 	/// Disables obstacle markers.
 	void disableObstacles();
+	/// Drops composed unit sprites, units could change outside of busy battle.
+	void invalidateUnitSprites();
 };
 
 }
@@ -26,6 +26,7 @@
 #include "../Mod/Mod.h"
 #include "../Savegame/BattleUnit.h"
 #include "../Engine/Options.h"
+#include "../Engine/PhaseTimer.h"
 #include "../fmath.h"
 #include "BattlescapeGame.h"
 
@@ -35,6 +36,7 @@ namespace OpenXcom
 constexpr int Pathfinding::dir_x[Pathfinding::dir_max];
 constexpr int Pathfinding::dir_y[Pathfinding::dir_max];
 constexpr int Pathfinding::dir_z[Pathfinding::dir_max];
+constexpr Position Pathfinding::partOffsets[4];
 
 int Pathfinding::red = 3;
 int Pathfinding::yellow = 10;
@@ -58,6 +60,7 @@ Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPr
 		_nodes.push_back(PathfindingNode(_save->getTileCoords(i)));
 		_altNodes.push_back(PathfindingNode(_save->getTileCoords(i)));
 	}
+	_costCache.init(_save->getMapSizeX(), _save->getMapSizeY(), _save->getMapSizeZ());
 }
 
 /**
@@ -76,9 +79,31 @@ Pathfinding::~Pathfinding()
  */
 PathfindingNode *Pathfinding::getNode(Position pos, bool alt)
 {
-	if (alt)
-		return &_altNodes[_save->getTileIndex(pos)];
-	return &_nodes[_save->getTileIndex(pos)];
+	PathfindingNode *node = alt ? &_altNodes[_save->getTileIndex(pos)] : &_nodes[_save->getTileIndex(pos)];
+	node->reset(_nodesGeneration);
+	return node;
+}
+
+/**
+ * Starts new search, nodes are not touched here but lazily reset in `getNode`
+ * when their generation do not match current one.
+ */
+void Pathfinding::resetNodes()
+{
+	_openSet.clear();
+	if (++_nodesGeneration == 0)
+	{
+		// counter wrapped around, old generations could match again
+		for (auto& pn : _nodes)
+		{
+			pn.reset(0);
+		}
+		for (auto& pn : _altNodes)
+		{
+			pn.reset(0);
+		}
+		_nodesGeneration = 1;
+	}
 }
 
 /**
@@ -103,6 +128,7 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleAction
  */
 void Pathfinding::calculate(BattleUnit *unit, Position startPosition, Position endPosition, BattleActionMove bam, const BattleUnit *missileTarget, int maxTUCost)
 {
+	PhaseTimer::Scope phaseScope(TP_PATHFINDING);
 	_totalTUCost = {};
 	_path.clear();
 
@@ -206,15 +232,12 @@ void Pathfinding::calculate(BattleUnit *unit, Position startPosition, Position e
 bool Pathfinding::aStarPath(Position startPosition, Position endPosition, BattleActionMove bam, const BattleUnit *missileTarget, bool sneak, int maxTUCost)
 {
 	// reset every node, so we have to check them all
-	for (auto& pn : _nodes)
-	{
-		pn.reset();
-	}
+	resetNodes();
 
 	// start position is the first one in our "open" list
 	PathfindingNode *start = getNode(startPosition);
 	start->connect({}, 0, 0, endPosition);
-	PathfindingOpenSet openList;
+	PathfindingOpenSet &openList = _openSet;
 	openList.push(start);
 	bool missile = (bam == BAM_MISSILE);
 	// if the open list is empty, we've reached the end
@@ -261,19 +284,56 @@ bool Pathfinding::aStarPath(Position startPosition, Position endPosition, Battle
 }
 
 /**
- * Gets the TU cost to move from 1 tile to the other (ONE STEP ONLY).
- * But also updates the endPosition, because it is possible
- * the unit goes upstairs or falls down while walking.
+ * Notifies pathfinding that terrain of tile changed, cached costs of steps near it are dropped.
+ * @param tile Tile that changed.
+ */
+void Pathfinding::tileTerrainChanged(Tile *tile)
+{
+	_costCache.invalidate(tile->getPosition());
+	_reachability.invalidate(tile->getPosition(), tile->getPosition());
+}
+
+/**
+ * Notifies pathfinding that unit left old tile and entered its current tile, floods near both are dropped.
+ * @param unit Unit that moved.
+ * @param oldTile Tile where unit was before, can be null.
+ */
+void Pathfinding::unitTileChanged(BattleUnit *unit, Tile *oldTile)
+{
+	const Position size = Position(unit->getArmor()->getSize() - 1, unit->getArmor()->getSize() - 1, 0);
+	for (Tile *t : { oldTile, unit->getTile() })
+	{
+		if (t)
+		{
+			_reachability.invalidate(t->getPosition(), t->getPosition() + size);
+		}
+	}
+}
+
+/**
+ * Notifies pathfinding that fire or smoke on tile changed, floods near it are dropped.
+ * Terrain part of step costs does not include fire and smoke, so it stays valid.
+ * @param tile Tile that changed.
+ */
+void Pathfinding::tileFireOrSmokeChanged(Tile *tile)
+{
+	_reachability.invalidate(tile->getPosition(), tile->getPosition());
+}
+
+/**
+ * Gets the part of step cost that depend only on terrain (ONE STEP ONLY).
+ * Units in the way, fire and smoke are not checked here, only parts that need such checks are marked.
+ * For normal moves result depend only on movement type and size of unit.
  * @param startPosition The position to start from.
  * @param direction The direction we are facing.
- * @param endPosition The position we want to reach.
  * @param unit The unit moving.
  * @param missileTarget The target unit used for BAM_MISSILE.
  * @param bam What move type is required (one special case is BAM_MISSILE)?
- * @return TU cost or 255 if movement is impossible.
+ * @return Terrain step, flagged as blocked if movement is impossible.
  */
-PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, const BattleUnit *unit, const BattleUnit *missileTarget, BattleActionMove bam) const
+PathfindingTerrainStep Pathfinding::getTUCostTerrain(Position startPosition, int direction, const BattleUnit *unit, const BattleUnit *missileTarget, BattleActionMove bam) const
 {
+	PathfindingTerrainStep step;
 	Position pos;
 	directionToVector(direction, &pos);
 	pos += startPosition;
@@ -291,13 +351,6 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 	int maskOfPartsClimb = 0x0;
 	int maskArmor = size ? 0xF : 0x1;
 
-	Position offsets[4] =
-	{
-		{ 0, 0, 0 },
-		{ 1, 0, 0 },
-		{ 0, 1, 0 },
-		{ 1, 1, 0 },
-	};
 	const Tile* startTile[4] = { };
 	const Tile* aboveStart[4] = { };
 	const Tile* belowStart[4] = { };
@@ -308,11 +361,11 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 	// init variables
 	for (int i = 0; i < numberOfParts; ++i)
 	{
-		const Tile* st = _save->getTile(startPosition + offsets[i]);
-		const Tile* dt = _save->getTile(pos + offsets[i]);
+		const Tile* st = _save->getTile(startPosition + partOffsets[i]);
+		const Tile* dt = _save->getTile(pos + partOffsets[i]);
 		if (!st || !dt)
 		{
-			return {{INVALID_MOVE_COST, 0}};
+			return PathfindingTerrainStep::blocked();
 		}
 		startTile[i] = st;
 		aboveStart[i] = _save->getAboveTile(st);
@@ -332,9 +385,9 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		{
 			// check if we can go this way
 			if (isBlockedDirection(unit, startTile[i], direction, bam, missileTarget))
-				return {{INVALID_MOVE_COST, 0}};
+				return PathfindingTerrainStep::blocked();
 			if (startTile[i]->getTerrainLevel() - destinationTile[i]->getTerrainLevel() > 8)
-				return {{INVALID_MOVE_COST, 0}};
+				return PathfindingTerrainStep::blocked();
 		}
 
 		// if we are on a stairs try to go up a level
@@ -348,23 +401,8 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		}
 		else if (bam != BAM_MISSILE && movementType == MT_FLY)
 		{
-			// 2 or more voxels poking into this tile = no go
-			auto overlaping = destinationTile[i]->getOverlappingUnit(_save, TUO_IGNORE_SMALL);
-			bool knowsOfOverlapping = false;
-			if (overlaping)
-			{
-				if (unit->getFaction() == FACTION_PLAYER && overlaping->getVisible())
-					knowsOfOverlapping = true; // player know all visible units
-				if (unit->getFaction() == overlaping->getFaction() && !_ignoreFriends)
-					knowsOfOverlapping = true;
-				if (unit->getFaction() != FACTION_PLAYER &&
-					std::find(unit->getUnitsSpottedThisTurn().begin(), unit->getUnitsSpottedThisTurn().end(), overlaping) != unit->getUnitsSpottedThisTurn().end())
-					knowsOfOverlapping = true;
-				if (overlaping != unit && overlaping != missileTarget && knowsOfOverlapping)
-				{
-					return {{INVALID_MOVE_COST, 0}};
-				}
-			}
+			// units poking into this tile are checked later
+			step.overlapMask |= maskCurrentPart;
 		}
 
 		if (aboveStart[i] && aboveStart[i]->hasNoFloor(_save))
@@ -404,7 +442,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 	{
 		if (direction != DIR_DOWN)
 		{
-			return {{INVALID_MOVE_COST, 0}}; //cannot walk on air
+			return PathfindingTerrainStep::blocked(); //cannot walk on air
 		}
 	}
 
@@ -419,10 +457,14 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 			destinationTile[i] = belowDestination[i];
 		}
 
-		// check if the destination tile can be walked over
-		if (isBlocked(unit, destinationTile[i], O_FLOOR, bam, missileTarget) || isBlocked(unit, destinationTile[i], O_OBJECT, bam, missileTarget))
+		// check if the destination tile can be walked over, units standing on floor can change result so it is checked later
+		if (destinationTile[i] == nullptr || isBlockedTerrain(unit, destinationTile[i], O_OBJECT, bam, missileTarget))
 		{
-			return {{INVALID_MOVE_COST, 0}};
+			return PathfindingTerrainStep::blocked();
+		}
+		if (isBlockedTerrain(unit, destinationTile[i], O_FLOOR, bam, missileTarget))
+		{
+			step.floorMask |= 1 << i;
 		}
 	}
 
@@ -433,28 +475,11 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		if ((t->isDoor(O_NORTHWALL)) ||
 			(t->isDoor(O_WESTWALL)))
 		{
-			return {{INVALID_MOVE_COST, 0}};
+			return PathfindingTerrainStep::blocked();
 		}
 	}
 
-	// pre-calculate fire penalty (to make it consistent for 2x2 units)
-	auto firePenaltyCost = 0;
-	if (unit->getFaction() != FACTION_PLAYER &&
-		unit->avoidsFire())
-	{
-		for (int i = 0; i < numberOfParts; ++i)
-		{
-			if (destinationTile[i]->getFire() > 0)
-			{
-				firePenaltyCost = FIRE_PREVIEW_MOVE_COST; // try to find a better path, but don't exclude this path entirely.
-			}
-		}
-	}
-
-
 	// calculate cost and some final checks
-	auto totalCost = 0;
-
 	for (int i = 0; i < numberOfParts; ++i)
 	{
 		auto cost = 0;
@@ -464,9 +489,9 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		{
 			// check if we can go this way
 			if (isBlockedDirection(unit, startTile[i], direction, bam, missileTarget))
-				return {{INVALID_MOVE_COST, 0}};
+				return PathfindingTerrainStep::blocked();
 			if (startTile[i]->getTerrainLevel() - destinationTile[i]->getTerrainLevel() > 8)
-				return {{INVALID_MOVE_COST, 0}};
+				return PathfindingTerrainStep::blocked();
 		}
 		else if (direction >= DIR_UP && !triedStairsDown)
 		{
@@ -491,7 +516,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 
 					if (minCost >= INVALID_MOVE_COST)
 					{
-						return {{INVALID_MOVE_COST, 0}};
+						return PathfindingTerrainStep::blocked();
 					}
 					cost = minCost;
 				}
@@ -502,7 +527,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 			}
 			else
 			{
-				return {{INVALID_MOVE_COST, 0}};
+				return PathfindingTerrainStep::blocked();
 			}
 		}
 		if (upperLevel)
@@ -513,9 +538,9 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 			{
 				// check if we can go this way
 				if (isBlockedDirection(unit, startTile[i], direction, bam, missileTarget))
-					return {{INVALID_MOVE_COST, 0}};
+					return PathfindingTerrainStep::blocked();
 				if (startTile[i]->getTerrainLevel() - destinationTile[i]->getTerrainLevel() > 8)
-					return {{INVALID_MOVE_COST, 0}};
+					return PathfindingTerrainStep::blocked();
 			}
 		}
 
@@ -570,7 +595,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		// for backward compatiblity (100 + 100 + 100 > 255) or for (255 + 10 > 255)
 		if (wallcost >= INVALID_MOVE_COST)
 		{
-			return {{INVALID_MOVE_COST, 0}};
+			return PathfindingTerrainStep::blocked();
 		}
 
 		// if we don't want to fall down and there is no floor, we can't know the TUs so it's default to 4
@@ -607,12 +632,6 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 
 		cost += wallcost;
 
-		// TFTD thing: underwater tiles on fire or filled with smoke cost 2 TUs more for whatever reason.
-		if (_save->getDepth() > 0 && (destinationTile[i]->getFire() > 0 || destinationTile[i]->getSmoke() > 0))
-		{
-			cost += 2;
-		}
-
 		if (missileTarget && destinationTile[i]->getUnit())
 		{
 			BattleUnit *unitHere = destinationTile[i]->getUnit();
@@ -620,61 +639,153 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 			{
 				if (unitHere->getFaction() == unit->getFaction())
 				{
-					return {{INVALID_MOVE_COST, 0}}; // consider any tile occupied by a friendly as being blocked
+					return PathfindingTerrainStep::blocked(); // consider any tile occupied by a friendly as being blocked
 				}
 				else if (unit->getUnitRules() && unitHere->getTurnsSinceSpottedByFaction(unit->getFaction()) <= unit->getUnitRules()->getIntelligence())
 				{
-					return {{INVALID_MOVE_COST, 0}}; // consider any tile occupied by a known unit that isn't our target as being blocked
+					return PathfindingTerrainStep::blocked(); // consider any tile occupied by a known unit that isn't our target as being blocked
 				}
 			}
 		}
 
-		// Strafing costs +1 for forwards-ish or sidewards, propose +2 for backwards-ish directions
-		// Maybe if flying then it makes no difference?
-		if (_strafeMove && bam == BAM_STRAFE)
-		{
-			if (unit->getDirection() != direction)
-			{
-				cost += 1;
-			}
-		}
-
-		// cap move cost to given limit
-		cost = std::min(cost, +MAX_MOVE_COST);
-
-		totalCost += cost;
+		// cap move cost to given limit, extra costs added later can't go over it too
+		step.partCost[i] = std::min(cost, +MAX_MOVE_COST);
 	}
 
 	// because unit move up or down we adjust final position
 	if (triedStairs)
 	{
-		pos.z++;
+		step.deltaZ = +1;
 	}
 	else if (direction != DIR_DOWN && triedStairsDown)
 	{
-		pos.z--;
+		step.deltaZ = -1;
 	}
+	pos.z += step.deltaZ;
 
 	// for bigger sized units, check the path between parts in an X shape at the end position
 	if (size)
 	{
-		totalCost /= numberOfParts;
 		const Tile *originTile = _save->getTile(pos + Position(1,1,0));
 		const Tile *finalTile = _save->getTile(pos);
 		int tmpDirection = 7;
 		if (isBlockedDirection(unit, originTile, tmpDirection, bam, missileTarget))
-			return {{INVALID_MOVE_COST, 0}};
+			return PathfindingTerrainStep::blocked();
 		if (!triedStairsDown && abs(originTile->getTerrainLevel() - finalTile->getTerrainLevel()) > 10)
-			return {{INVALID_MOVE_COST, 0}};
+			return PathfindingTerrainStep::blocked();
 		originTile = _save->getTile(pos + Position(1,0,0));
 		finalTile = _save->getTile(pos + Position(0,1,0));
 		tmpDirection = 5;
 		if (isBlockedDirection(unit, originTile, tmpDirection, bam, missileTarget))
-			return {{INVALID_MOVE_COST, 0}};
+			return PathfindingTerrainStep::blocked();
 		if (!triedStairsDown && abs(originTile->getTerrainLevel() - finalTile->getTerrainLevel()) > 10)
+			return PathfindingTerrainStep::blocked();
+	}
+
+
+	if (fallingDown)
+	{
+		step.flags |= PathfindingTerrainStep::TSF_FALLING;
+	}
+	if (flying)
+	{
+		step.flags |= PathfindingTerrainStep::TSF_FLYING;
+	}
+	if (climb)
+	{
+		step.flags |= PathfindingTerrainStep::TSF_CLIMB;
+	}
+	return step;
+}
+
+/**
+ * Gets the TU cost to move from 1 tile to the other (ONE STEP ONLY).
+ * But also updates the endPosition, because it is possible
+ * the unit goes upstairs or falls down while walking.
+ * Terrain part of cost is taken from cache when possible, units, fire and smoke are always checked.
+ * @param startPosition The position to start from.
+ * @param direction The direction we are facing.
+ * @param endPosition The position we want to reach.
+ * @param unit The unit moving.
+ * @param missileTarget The target unit used for BAM_MISSILE.
+ * @param bam What move type is required (one special case is BAM_MISSILE)?
+ * @return TU cost or 255 if movement is impossible.
+ */
+PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, const BattleUnit *unit, const BattleUnit *missileTarget, BattleActionMove bam) const
+{
+	Position pos;
+	directionToVector(direction, &pos);
+	pos += startPosition;
+
+	const auto movementType = getMovementType(unit, missileTarget, bam);
+	const Armor* armor =  unit->getArmor();
+	const int size = armor->getSize() - 1;
+	const int numberOfParts = armor->getTotalSize();
+
+	// missiles check doors and targets, and `validateUpDown` use unit own movement type, do not cache these cases
+	const bool cacheable = bam != BAM_MISSILE && missileTarget == nullptr && size < PathfindingCostCache::SizeCount
+		&& unit->getMovementType() == movementType && _save->getTile(startPosition) != nullptr;
+	const int startIndex = cacheable ? _save->getTileIndex(startPosition) : -1;
+	const PathfindingTerrainStep *cached = cacheable ? _costCache.find(startIndex, direction, movementType, size) : nullptr;
+	PathfindingTerrainStep terrain;
+	if (cached)
+	{
+		terrain = *cached;
+	}
+	else
+	{
+		terrain = getTUCostTerrain(startPosition, direction, unit, missileTarget, bam);
+		if (cacheable)
+		{
+			_costCache.store(startIndex, direction, movementType, size, terrain);
+		}
+	}
+
+	if (terrain.flags & PathfindingTerrainStep::TSF_BLOCKED)
+	{
+		return {{INVALID_MOVE_COST, 0}};
+	}
+	const bool fallingDown = terrain.flags & PathfindingTerrainStep::TSF_FALLING;
+	const bool flying = terrain.flags & PathfindingTerrainStep::TSF_FLYING;
+	const bool climb = terrain.flags & PathfindingTerrainStep::TSF_CLIMB;
+
+	// 2 or more voxels poking into this tile = no go
+	for (int i = 0; i < numberOfParts; ++i)
+	{
+		if ((terrain.overlapMask & (1 << i)) && isBlockedByOverlappingUnit(unit, _save->getTile(pos + partOffsets[i]), missileTarget))
+		{
 			return {{INVALID_MOVE_COST, 0}};
+		}
 	}
 
+	pos.z += terrain.deltaZ;
+
+	const Tile* destinationTile[4] = { };
+	for (int i = 0; i < numberOfParts; ++i)
+	{
+		destinationTile[i] = _save->getTile(pos + partOffsets[i]);
+
+		// check if units allow to enter destination tile
+		const auto unitBlocking = isBlockedByUnit(unit, destinationTile[i], bam, missileTarget);
+		if (unitBlocking == UB_BLOCK || (unitBlocking == UB_NONE && (terrain.floorMask & (1 << i))))
+		{
+			return {{INVALID_MOVE_COST, 0}};
+		}
+	}
+
+	// pre-calculate fire penalty (to make it consistent for 2x2 units)
+	auto firePenaltyCost = 0;
+	if (unit->getFaction() != FACTION_PLAYER &&
+		unit->avoidsFire())
+	{
+		for (int i = 0; i < numberOfParts; ++i)
+		{
+			if (destinationTile[i]->getFire() > 0)
+			{
+				firePenaltyCost = FIRE_PREVIEW_MOVE_COST; // try to find a better path, but don't exclude this path entirely.
+			}
+		}
+	}
 
 	if (bam == BAM_MISSILE)
 	{
@@ -686,6 +797,37 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		return { { }, { firePenaltyCost, 0 }, pos };
 	}
 
+	auto totalCost = 0;
+	for (int i = 0; i < numberOfParts; ++i)
+	{
+		int cost = terrain.partCost[i];
+
+		// TFTD thing: underwater tiles on fire or filled with smoke cost 2 TUs more for whatever reason.
+		if (_save->getDepth() > 0 && (destinationTile[i]->getFire() > 0 || destinationTile[i]->getSmoke() > 0))
+		{
+			cost += 2;
+		}
+
+		// Strafing costs +1 for forwards-ish or sidewards, propose +2 for backwards-ish directions
+		// Maybe if flying then it makes no difference?
+		if (_strafeMove && bam == BAM_STRAFE)
+		{
+			if (unit->getDirection() != direction)
+			{
+				cost += 1;
+			}
+		}
+
+		// cap move cost to given limit
+		cost = std::min(cost, +MAX_MOVE_COST);
+
+		totalCost += cost;
+	}
+	if (size)
+	{
+		totalCost /= numberOfParts;
+	}
+
 	const auto costDiv = 100 * 100 * 100;
 	ArmorMoveCost cost = { totalCost, totalCost };
 
@@ -855,6 +997,118 @@ bool Pathfinding::isBlocked(const BattleUnit *unit, const Tile *tile, const int
 {
 	if (tile == 0) return true; // probably outside the map here
 
+	if (part == O_FLOOR)
+	{
+		const auto unitBlocking = isBlockedByUnit(unit, tile, bam, missileTarget);
+		if (unitBlocking != UB_NONE)
+		{
+			return unitBlocking == UB_BLOCK;
+		}
+	}
+	return isBlockedTerrain(unit, tile, part, bam, missileTarget, bigWallExclusion);
+}
+
+/**
+ * Determines whether units on or below a tile decide if unit can enter it.
+ * @param unit Unit that move.
+ * @param tile Specified tile.
+ * @param bam Move type.
+ * @param missileTarget Target for a missile.
+ * @return `UB_BLOCK` or `UB_PASS` if units decide it, `UB_NONE` when terrain decide it.
+ */
+Pathfinding::UnitBlocking Pathfinding::isBlockedByUnit(const BattleUnit *unit, const Tile *tile, BattleActionMove bam, const BattleUnit *missileTarget) const
+{
+	auto movementType = getMovementType(unit, missileTarget, bam);
+
+	if (tile->getUnit() && !_ignoreFriends)
+	{
+		BattleUnit *u = tile->getUnit();
+		if (u == unit || u == missileTarget || u->isOut())
+			return UB_PASS;
+		if (missileTarget && u != missileTarget && u->getFaction() == _unit->getFaction())
+			return UB_BLOCK;			// AI pathfinding with missiles shouldn't path through their own units
+		if (unit)
+		{
+			if (unit->getFaction() == FACTION_PLAYER && u->getVisible())
+				return UB_BLOCK; // player know all visible units
+			if (unit->getFaction() == u->getFaction())
+				return UB_BLOCK;
+			if (unit->getFaction() != FACTION_PLAYER &&
+				std::find(unit->getUnitsSpottedThisTurn().begin(), unit->getUnitsSpottedThisTurn().end(), u) != unit->getUnitsSpottedThisTurn().end())
+				return UB_BLOCK;
+		}
+	}
+	else if (tile->hasNoFloor(0) && movementType != MT_FLY) // this whole section is devoted to making large units not take part in any kind of falling behaviour
+	{
+		Position pos = tile->getPosition();
+		while (pos.z >= 0)
+		{
+			Tile *t = _save->getTile(pos);
+			BattleUnit *u = t->getUnit();
+
+			if (u != 0 && u != unit)
+			{
+				// don't let large units fall on other units
+				if (unit && unit->isBigUnit())
+				{
+					return UB_BLOCK;
+				}
+				// don't let any units fall on large units
+				if (u != unit && u != missileTarget && !u->isOut() && u->isBigUnit())
+				{
+					return UB_BLOCK;
+				}
+			}
+			// not gonna fall any further, so we can stop checking.
+			if (!t->hasNoFloor(0))
+			{
+				break;
+			}
+			pos.z--;
+		}
+	}
+	return UB_NONE;
+}
+
+/**
+ * Determines whether a flying unit can't enter a tile because other unit below is poking into it.
+ * @param unit Unit that move.
+ * @param tile Specified tile.
+ * @param missileTarget Target for a missile.
+ * @return True if the movement is blocked.
+ */
+bool Pathfinding::isBlockedByOverlappingUnit(const BattleUnit *unit, const Tile *tile, const BattleUnit *missileTarget) const
+{
+	auto overlaping = tile->getOverlappingUnit(_save, TUO_IGNORE_SMALL);
+	bool knowsOfOverlapping = false;
+	if (overlaping)
+	{
+		if (unit->getFaction() == FACTION_PLAYER && overlaping->getVisible())
+			knowsOfOverlapping = true; // player know all visible units
+		if (unit->getFaction() == overlaping->getFaction() && !_ignoreFriends)
+			knowsOfOverlapping = true;
+		if (unit->getFaction() != FACTION_PLAYER &&
+			std::find(unit->getUnitsSpottedThisTurn().begin(), unit->getUnitsSpottedThisTurn().end(), overlaping) != unit->getUnitsSpottedThisTurn().end())
+			knowsOfOverlapping = true;
+		if (overlaping != unit && overlaping != missileTarget && knowsOfOverlapping)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Determines whether terrain of a certain part of a tile blocks movement, units are ignored.
+ * @param tile Specified tile, can be a null pointer.
+ * @param part Part of the tile.
+ * @param missileTarget Target for a missile.
+ * @return True if the movement is blocked.
+ */
+bool Pathfinding::isBlockedTerrain(const BattleUnit *unit, const Tile *tile, const int part, BattleActionMove bam, const BattleUnit *missileTarget, int bigWallExclusion) const
+{
+	if (tile == 0) return true; // probably outside the map here
+
 	auto movementType = getMovementType(unit, missileTarget, bam);
 
 	if (part == O_BIGWALL)
@@ -894,56 +1148,6 @@ bool Pathfinding::isBlocked(const BattleUnit *unit, const Tile *tile, const int
 			 tileNorth->getMapData(O_OBJECT)->getBigWall() == BIGWALLEASTANDSOUTH))
 			return true; // blocking part
 	}
-	if (part == O_FLOOR)
-	{
-		if (tile->getUnit() && !_ignoreFriends)
-		{
-			BattleUnit *u = tile->getUnit();
-			if (u == unit || u == missileTarget || u->isOut())
-				return false;
-			if (missileTarget && u != missileTarget && u->getFaction() == _unit->getFaction())
-				return true;			// AI pathfinding with missiles shouldn't path through their own units
-			if (unit)
-			{
-				if (unit->getFaction() == FACTION_PLAYER && u->getVisible())
-					return true; // player know all visible units
-				if (unit->getFaction() == u->getFaction())
-					return true;
-				if (unit->getFaction() != FACTION_PLAYER &&
-					std::find(unit->getUnitsSpottedThisTurn().begin(), unit->getUnitsSpottedThisTurn().end(), u) != unit->getUnitsSpottedThisTurn().end())
-					return true;
-			}
-		}
-		else if (tile->hasNoFloor(0) && movementType != MT_FLY) // this whole section is devoted to making large units not take part in any kind of falling behaviour
-		{
-			Position pos = tile->getPosition();
-			while (pos.z >= 0)
-			{
-				Tile *t = _save->getTile(pos);
-				BattleUnit *u = t->getUnit();
-
-				if (u != 0 && u != unit)
-				{
-					// don't let large units fall on other units
-					if (unit && unit->isBigUnit())
-					{
-						return true;
-					}
-					// don't let any units fall on large units
-					if (u != unit && u != missileTarget && !u->isOut() && u->isBigUnit())
-					{
-						return true;
-					}
-				}
-				// not gonna fall any further, so we can stop checking.
-				if (!t->hasNoFloor(0))
-				{
-					break;
-				}
-				pos.z--;
-			}
-		}
-	}
 	// missiles can't pathfind through closed doors.
 	{
 		TilePart tp = (TilePart)part;
@@ -1523,6 +1727,7 @@ std::vector<int> Pathfinding::findReachable(BattleUnit *unit, const BattleAction
  */
 std::vector<PathfindingNode*> Pathfinding::findReachablePathFindingNodes(BattleUnit* unit, const BattleActionCost& cost, bool& ranOutOfTUs, bool entireMap, const BattleUnit* missileTarget, const Position* alternateStart, bool justCheckIfAnyMovementIsPossible, bool useMaxTUs, BattleActionMove bam)
 {
+	PhaseTimer::Scope phaseScope(TP_PATHFINDING);
 	_unit = unit;
 	Position start = unit->getPosition();
 	if (alternateStart)
@@ -1537,25 +1742,6 @@ std::vector<PathfindingNode*> Pathfinding::findReachablePathFindingNodes(BattleU
 
 	PathfindingCost costMax = {tuMax, energyMax};
 
-	if (alternateStart)
-	{
-		for (auto& pn : _altNodes)
-		{
-			pn.reset();
-		}
-	}
-	else
-	{
-		for (auto& pn : _nodes)
-		{
-			pn.reset();
-		}
-	}
-	PathfindingNode *startNode = getNode(start, alternateStart);
-	startNode->connect({}, 0, 0);
-	PathfindingOpenSet unvisited;
-	unvisited.push(startNode);
-	std::vector<PathfindingNode *> reachable;
 	int maxTilesToReturn = _size;
 	if (Options::aiPerformanceOptimization)
 	{
@@ -1569,6 +1755,76 @@ std::vector<PathfindingNode*> Pathfinding::findReachablePathFindingNodes(BattleU
 		if (scaleFactor < 1)
 			maxTilesToReturn *= scaleFactor;
 	}
+
+	// same flood is often requested many times in one turn, reuse it if nothing changed
+	const bool cacheable = !justCheckIfAnyMovementIsPossible && bam != BAM_STRAFE && _save->getTile(start) != nullptr;
+	ReachabilityKey key;
+	if (cacheable)
+	{
+		key.unit = unit;
+		key.unitPosition = unit->getPosition();
+		key.start = start;
+		key.armor = unit->getArmor();
+		key.movementType = unit->getMovementType();
+		key.faction = unit->getFaction();
+		key.missileTarget = missileTarget;
+		key.costMax = costMax;
+		key.maxTilesToReturn = maxTilesToReturn;
+		key.bam = bam;
+		key.entireMap = entireMap;
+		key.alternate = alternateStart != nullptr;
+		key.ignoreFriends = _ignoreFriends;
+		// units that block path depend on what unit know about them
+		Uint64 known = 0;
+		auto addKnown = [&](const BattleUnit *bu)
+		{
+			known = known * 0x100000001B3ull + (Uint64)bu->getId() + 1;
+		};
+		if (unit->getFaction() == FACTION_PLAYER)
+		{
+			for (BattleUnit *bu : *(_save->getUnits()))
+			{
+				if (bu->getVisible())
+					addKnown(bu);
+			}
+		}
+		else
+		{
+			for (BattleUnit *bu : unit->getUnitsSpottedThisTurn())
+			{
+				addKnown(bu);
+			}
+		}
+		key.knownUnits = known;
+
+		if (const auto *field = _reachability.find(key))
+		{
+			if (field->ranOutOfTUs)
+				ranOutOfTUs = true;
+			resetNodes();
+			std::vector<PathfindingNode *> reachable;
+			reachable.reserve(field->nodes.size());
+			for (const auto& rn : field->nodes)
+			{
+				PathfindingNode *node = getNode(rn.pos, alternateStart);
+				if (rn.hasPrev)
+					node->connect(rn.cost, getNode(rn.prevPos, alternateStart), rn.prevDir);
+				else
+					node->connect(rn.cost, 0, 0);
+				node->setChecked();
+				reachable.push_back(node);
+			}
+			return reachable;
+		}
+	}
+
+	resetNodes();
+	PathfindingNode *startNode = getNode(start, alternateStart);
+	startNode->connect({}, 0, 0);
+	PathfindingOpenSet &unvisited = _openSet;
+	unvisited.push(startNode);
+	std::vector<PathfindingNode *> reachable;
+	bool floodRanOutOfTUs = false;
 	int strictMaxTilesToReturn = _size;
 	while (!unvisited.empty())
 	{
@@ -1588,6 +1844,7 @@ std::vector<PathfindingNode*> Pathfinding::findReachablePathFindingNodes(BattleU
 			if (!(totalTuCost <= costMax) && !entireMap) // Run out of TUs/Energy
 			{
 				ranOutOfTUs = true;
+				floodRanOutOfTUs = true;
 				continue;
 			}
 			PathfindingNode *nextNode = getNode(r.pos, alternateStart);
@@ -1606,6 +1863,10 @@ std::vector<PathfindingNode*> Pathfinding::findReachablePathFindingNodes(BattleU
 			break;
 	}
 	std::sort(reachable.begin(), reachable.end(), MinNodeCosts());
+	if (cacheable)
+	{
+		_reachability.store(key, reachable, floodRanOutOfTUs);
+	}
 	return reachable;
 }
 
@@ -20,6 +20,9 @@
 #include <vector>
 #include "Position.h"
 #include "PathfindingNode.h"
+#include "PathfindingOpenSet.h"
+#include "PathfindingCostCache.h"
+#include "ReachabilityCache.h"
 #include "../Mod/MapData.h"
 
 namespace OpenXcom
@@ -50,9 +53,21 @@ private:
 	constexpr static int dir_x[dir_max] = {  0, +1, +1, +1,  0, -1, -1, -1,  0,  0};
 	constexpr static int dir_y[dir_max] = { -1, -1,  0, +1, +1, +1,  0, -1,  0,  0};
 	constexpr static int dir_z[dir_max] = {  0,  0,  0,  0,  0,  0,  0,  0, +1, -1};
+	/// Offsets of parts of big unit.
+	constexpr static Position partOffsets[4] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } };
+
+	/// Result of checking units standing in the way.
+	enum UnitBlocking { UB_NONE, UB_PASS, UB_BLOCK };
 
 	SavedBattleGame *_save;
 	std::vector<PathfindingNode> _nodes, _altNodes;
+	/// Number of current search, nodes with other number are treated as unvisited.
+	Uint32 _nodesGeneration = 0;
+	PathfindingOpenSet _openSet;
+	/// Terrain part of step costs, filled lazily by `getTUCost`.
+	mutable PathfindingCostCache _costCache;
+	/// Floods done by `findReachablePathFindingNodes` in current turn.
+	ReachabilityCache _reachability;
 	int _size;
 	BattleUnit *_unit;
 	bool _pathPreviewed;
@@ -64,11 +79,21 @@ private:
 
 	/// Gets the node at certain position.
 	PathfindingNode *getNode(Position pos, bool alt = false);
+	/// Starts new search, all nodes become unvisited.
+	void resetNodes();
 
 	/// Gets movement type of unit or movement of missile.
 	MovementType getMovementType(const BattleUnit *unit, const BattleUnit *missileTarget, BattleActionMove bam) const;
 	/// Determines whether a tile blocks a certain movementType.
 	bool isBlocked(const BattleUnit *unit, const Tile *tile, const int part, BattleActionMove bam, const BattleUnit *missileTarget, int bigWallExclusion = -1) const;
+	/// Determines whether units on a tile block a certain movementType.
+	UnitBlocking isBlockedByUnit(const BattleUnit *unit, const Tile *tile, BattleActionMove bam, const BattleUnit *missileTarget) const;
+	/// Determines whether unit below a tile block flying into it.
+	bool isBlockedByOverlappingUnit(const BattleUnit *unit, const Tile *tile, const BattleUnit *missileTarget) const;
+	/// Determines whether terrain of a tile blocks a certain movementType.
+	bool isBlockedTerrain(const BattleUnit *unit, const Tile *tile, const int part, BattleActionMove bam, const BattleUnit *missileTarget, int bigWallExclusion = -1) const;
+	/// Gets the part of step cost that depend only on terrain.
+	PathfindingTerrainStep getTUCostTerrain(Position startPosition, int direction, const BattleUnit *unit, const BattleUnit *missileTarget, BattleActionMove bam) const;
 	/// Determines whether or not movement between start tile and end tile is possible in the direction.
 	bool isBlockedDirection(const BattleUnit *unit, const Tile *startTile, const int direction, BattleActionMove bam, const BattleUnit *missileTarget) const;
 	/// Tries to find a straight line path between two positions.
@@ -261,6 +286,14 @@ public:
 	int getStartDirection() const;
 	/// Dequeues a direction.
 	int dequeuePath();
+	/// Notifies that terrain of tile changed.
+	void tileTerrainChanged(Tile *tile);
+	/// Notifies that unit changed its tile.
+	void unitTileChanged(BattleUnit *unit, Tile *oldTile);
+	/// Notifies that fire or smoke on tile changed.
+	void tileFireOrSmokeChanged(Tile *tile);
+	/// Gets floods reused in current turn.
+	ReachabilityCache &getReachabilityCache() { return _reachability; }
 	/// Gets the TU cost to move from 1 tile to the other.
 	PathfindingStep getTUCost(Position startPosition, int direction, const BattleUnit *unit, const BattleUnit *missileTarget, BattleActionMove bam) const;
 	/// Aborts the current path.
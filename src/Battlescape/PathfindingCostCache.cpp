@@ -0,0 +1,151 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include "PathfindingCostCache.h"
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates empty cache.
+ */
+PathfindingCostCache::PathfindingCostCache()
+{
+
+}
+
+/**
+ * Cleans up the cache.
+ */
+PathfindingCostCache::~PathfindingCostCache()
+{
+
+}
+
+/**
+ * Sets size of map and clears all entries, memory for entries is allocated on first use.
+ * @param mapSizeX Width of map.
+ * @param mapSizeY Length of map.
+ * @param mapSizeZ Height of map.
+ */
+void PathfindingCostCache::init(int mapSizeX, int mapSizeY, int mapSizeZ)
+{
+	_mapSizeX = mapSizeX;
+	_mapSizeY = mapSizeY;
+	_mapSizeXYZ = mapSizeX * mapSizeY * mapSizeZ;
+	for (auto& movementType : _entries)
+	{
+		for (auto& size : movementType)
+		{
+			size.clear();
+		}
+	}
+	_columnStamps.assign(mapSizeX * mapSizeY, 0);
+	flush();
+}
+
+/**
+ * Finds cached step.
+ * @param tileIndex Index of start tile.
+ * @param direction Direction of step.
+ * @param movementType Movement type used by step.
+ * @param size Size of unit minus one.
+ * @return Step or null if there is no valid step in cache.
+ */
+const PathfindingTerrainStep *PathfindingCostCache::find(int tileIndex, int direction, MovementType movementType, int size)
+{
+	if (_strictBlockedChecking != Options::strictBlockedChecking)
+	{
+		_strictBlockedChecking = Options::strictBlockedChecking;
+		flush();
+		return nullptr;
+	}
+
+	const auto& entries = _entries[movementType][size];
+	if (entries.empty())
+	{
+		return nullptr;
+	}
+	const Entry& entry = entries[tileIndex * DirCount + direction];
+	if (entry.stamp != getStamp(tileIndex))
+	{
+		return nullptr;
+	}
+	return &entry.step;
+}
+
+/**
+ * Stores step in cache, it stays valid until terrain near start tile change.
+ * @param tileIndex Index of start tile.
+ * @param direction Direction of step.
+ * @param movementType Movement type used by step.
+ * @param size Size of unit minus one.
+ * @param step Step to store.
+ */
+void PathfindingCostCache::store(int tileIndex, int direction, MovementType movementType, int size, const PathfindingTerrainStep &step)
+{
+	auto& entries = _entries[movementType][size];
+	if (entries.empty())
+	{
+		entries.resize(_mapSizeXYZ * DirCount);
+	}
+	Entry& entry = entries[tileIndex * DirCount + direction];
+	entry.step = step;
+	entry.stamp = getStamp(tileIndex);
+}
+
+/**
+ * Invalidates all steps that could depend on given tile.
+ * Step can look up to two tiles away from start (big units and walls of neighbour tiles)
+ * and on any level (falling, stairs), so whole nearby columns are invalidated.
+ * @param tile Position of tile that changed.
+ */
+void PathfindingCostCache::invalidate(Position tile)
+{
+	if (_columnStamps.empty())
+	{
+		return;
+	}
+	const int minX = std::max(0, tile.x - Radius);
+	const int maxX = std::min(_mapSizeX - 1, tile.x + Radius);
+	const int minY = std::max(0, tile.y - Radius);
+	const int maxY = std::min(_mapSizeY - 1, tile.y + Radius);
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			_columnStamps[y * _mapSizeX + x] = ++_lastStamp;
+		}
+	}
+}
+
+/**
+ * Invalidates all steps.
+ */
+void PathfindingCostCache::flush()
+{
+	for (auto& stamp : _columnStamps)
+	{
+		// zero is reserved for never used entries
+		stamp = ++_lastStamp;
+	}
+}
+
+}
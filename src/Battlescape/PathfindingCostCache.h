@@ -0,0 +1,121 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+#include "../Mod/MapData.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Part of one pathfinding step that depend only on terrain.
+ * Units, fire and smoke are checked by `Pathfinding::getTUCost` after this.
+ */
+struct PathfindingTerrainStep
+{
+	enum Flags : Uint8
+	{
+		/// Step is impossible whatever units are around.
+		TSF_BLOCKED = 1 << 0,
+		/// All parts of unit fall down.
+		TSF_FALLING = 1 << 1,
+		/// All parts of unit fly.
+		TSF_FLYING = 1 << 2,
+		/// All parts of unit climb ladder.
+		TSF_CLIMB = 1 << 3,
+	};
+
+	/// Cost of each unit part, capped to `Pathfinding::MAX_MOVE_COST`.
+	Uint8 partCost[4] = { };
+	/// Parts where destination need be checked for units overlapping it from below.
+	Uint8 overlapMask = 0;
+	/// Parts where destination floor is blocking, unless unit check decide otherwise.
+	Uint8 floorMask = 0;
+	/// Combination of `Flags`.
+	Uint8 flags = 0;
+	/// Change of z of final position, when using stairs or falling.
+	Sint8 deltaZ = 0;
+
+	/// Creates step that is impossible.
+	static PathfindingTerrainStep blocked()
+	{
+		PathfindingTerrainStep step;
+		step.flags = TSF_BLOCKED;
+		return step;
+	}
+};
+
+/**
+ * Per battle cache of terrain part of pathfinding steps,
+ * one entry for each tile, direction, movement type and unit size.
+ * Map columns have stamps that are bumped when terrain near them change,
+ * entry is valid only when its stamp match stamp of its column.
+ */
+class PathfindingCostCache
+{
+public:
+	/// Number of directions of step.
+	static constexpr int DirCount = 10;
+	/// Number of different unit sizes.
+	static constexpr int SizeCount = 2;
+	/// Number of different movement types.
+	static constexpr int MovementTypeCount = MT_SINK + 1;
+	/// How far from start tile step can look for terrain.
+	static constexpr int Radius = 2;
+
+private:
+	/**
+	 * Helper struct with cached step.
+	 */
+	struct Entry
+	{
+		PathfindingTerrainStep step;
+		Uint32 stamp = 0;
+	};
+
+	std::vector<Entry> _entries[MovementTypeCount][SizeCount];
+	std::vector<Uint32> _columnStamps;
+	int _mapSizeX = 0, _mapSizeY = 0, _mapSizeXYZ = 0;
+	Uint32 _lastStamp = 0;
+	bool _strictBlockedChecking = false;
+
+	/// Gets stamp of column of tile.
+	Uint32 getStamp(int tileIndex) const { return _columnStamps[tileIndex % (_mapSizeX * _mapSizeY)]; }
+
+public:
+	/// Creates empty cache.
+	PathfindingCostCache();
+	/// Cleans up the cache.
+	~PathfindingCostCache();
+
+	/// Sets size of map and clears all entries.
+	void init(int mapSizeX, int mapSizeY, int mapSizeZ);
+	/// Finds cached step.
+	const PathfindingTerrainStep *find(int tileIndex, int direction, MovementType movementType, int size);
+	/// Stores step in cache.
+	void store(int tileIndex, int direction, MovementType movementType, int size, const PathfindingTerrainStep &step);
+	/// Invalidates all steps that could depend on given tile.
+	void invalidate(Position tile);
+	/// Invalidates all steps.
+	void flush();
+};
+
+}
@@ -25,7 +25,7 @@ namespace OpenXcom
  * Sets up a PathfindingNode.
  * @param pos Position.
  */
-PathfindingNode::PathfindingNode(Position pos) : _pos(pos), _prevNode(0), _prevDir(0), _tuGuess(0), _checked(0), _openentry(0)
+PathfindingNode::PathfindingNode(Position pos) : _pos(pos), _prevNode(0), _prevDir(0), _tuGuess(0), _checked(0), _generation(0), _openIndex(-1), _openCost(0)
 {
 
 }
@@ -47,15 +47,6 @@ Position PathfindingNode::getPosition() const
 	return _pos;
 }
 
-/**
- * Resets the node.
- */
-void PathfindingNode::reset()
-{
-	_checked = false;
-	_openentry = 0;
-}
-
 /**
  * Gets the checked status of this node.
  * @return True, if this node was checked.
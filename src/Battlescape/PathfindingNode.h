@@ -23,7 +23,6 @@ namespace OpenXcom
 {
 
 class PathfindingOpenSet;
-struct OpenSetEntry;
 
 /**
  * Cost of one step.
@@ -93,8 +92,11 @@ private:
 	Sint16 _tuGuess;
 	/// Is best path find for this tile.
 	bool _checked;
-	// Invasive field needed by PathfindingOpenSet
-	Uint8 _openentry;
+	/// Number of search that last used this node, other fields are stale when it does not match current one.
+	Uint32 _generation;
+	// Invasive fields needed by PathfindingOpenSet
+	int _openIndex;
+	int _openCost;
 	friend class PathfindingOpenSet;
 public:
 	/// Creates a new PathfindingNode class.
@@ -103,8 +105,16 @@ public:
 	~PathfindingNode();
 	/// Gets the node position.
 	Position getPosition() const;
-	/// Resets the node.
-	void reset();
+	/// Resets the node if it was used by other search.
+	void reset(Uint32 generation)
+	{
+		if (_generation != generation)
+		{
+			_generation = generation;
+			_checked = false;
+			_openIndex = -1;
+		}
+	}
 	/// Is checked?
 	bool isChecked() const;
 	/// Marks the node as checked.
@@ -116,7 +126,7 @@ public:
 	/// Gets the previous walking direction.
 	int getPrevDir() const;
 	/// Is this node already in a PathfindingOpenSet?
-	bool inOpenSet() const { return (_openentry != 0); }
+	bool inOpenSet() const { return (_openIndex >= 0); }
 	/// Gets the approximate cost to reach the target position.
 	int getTUGuess() const { return _tuGuess; }
 
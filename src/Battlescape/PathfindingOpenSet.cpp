@@ -17,64 +17,122 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
+#include <algorithm>
 #include "PathfindingOpenSet.h"
 #include "PathfindingNode.h"
 
 namespace OpenXcom
 {
 
+PathfindingOpenSet::~PathfindingOpenSet()
+{
+
+}
+
 /**
- * Cleans up all the entries still in set.
+ * Puts node in given place of heap and updates its index.
+ * @param node Node to place.
+ * @param index Place in heap.
  */
-PathfindingOpenSet::~PathfindingOpenSet()
+void PathfindingOpenSet::place(PathfindingNode *node, size_t index)
 {
+	_heap[index] = node;
+	node->_openIndex = (int)index;
+}
 
+/**
+ * Moves node up while it is cheaper than its parent.
+ * @param index Current place of node.
+ */
+void PathfindingOpenSet::siftUp(size_t index)
+{
+	PathfindingNode *nd = _heap[index];
+	while (index > 0)
+	{
+		const size_t parent = (index - 1) / Arity;
+		if (_heap[parent]->_openCost <= nd->_openCost)
+		{
+			break;
+		}
+		place(_heap[parent], index);
+		index = parent;
+	}
+	place(nd, index);
 }
 
 /**
- * Keeps removing all discarded entries that have come to the top of the queue.
+ * Moves node down while any of its children is cheaper.
+ * @param index Current place of node.
  */
-void PathfindingOpenSet::removeDiscarded()
+void PathfindingOpenSet::siftDown(size_t index)
 {
-	while (!_queue.empty() && _queue.top()._node->_openentry != _queue.top()._openentry)
+	PathfindingNode *nd = _heap[index];
+	const size_t size = _heap.size();
+	while (true)
 	{
-		_queue.pop();
+		const size_t first = index * Arity + 1;
+		if (first >= size)
+		{
+			break;
+		}
+		const size_t last = std::min(first + Arity, size);
+		size_t best = first;
+		for (size_t child = first + 1; child < last; ++child)
+		{
+			if (_heap[child]->_openCost < _heap[best]->_openCost)
+			{
+				best = child;
+			}
+		}
+		if (nd->_openCost <= _heap[best]->_openCost)
+		{
+			break;
+		}
+		place(_heap[best], index);
+		index = best;
 	}
+	place(nd, index);
 }
 
 /**
- * Gets the node with the least cost.
- * After this call, the node is no longer in the set. It is an error to call this when the set is empty.
- * @return A pointer to the node which had the least cost.
+ * Removes the cheapest node from the set.
+ * @return The node.
  */
 PathfindingNode *PathfindingOpenSet::pop()
 {
 	assert(!empty());
 
-	PathfindingNode *nd = _queue.top()._node;
-	_queue.pop();
-	nd->_openentry = 0;
-
-	// Discarded entries might be visible now.
-	removeDiscarded();
+	PathfindingNode *nd = _heap.front();
+	PathfindingNode *last = _heap.back();
+	_heap.pop_back();
+	if (!_heap.empty())
+	{
+		place(last, 0);
+		siftDown(0);
+	}
+	nd->_openIndex = -1;
 	return nd;
 }
 
 /**
- * Places the node in the set.
- * If the node was already in the set, the previous entry is discarded.
- * It is the caller's responsibility to never re-add a node with a worse cost.
- * @param node A pointer to the node to add.
+ * Adds node to the set, if node is already there its place is updated to its new cost.
+ * @param node The node.
  */
 void PathfindingOpenSet::push(PathfindingNode *node)
 {
-	assert(node->_openentry != 255u);
-
-	OpenSetEntry entry = {};
-	entry._node = node;
-	entry._cost = node->getTUCost(false).time * 4 + node->getTUGuess(); //HACK: this is not real cost, more rough approximation for algorithm, as bonus `getTUGuess` work more like gravity/potential than normal cost.
-	entry._openentry = ++node->_openentry; // next unique number, used to check if old recode is still valid.
-	_queue.push(entry);
+	node->_openCost = node->getTUCost(false).time * 4 + node->getTUGuess(); //HACK: this is not real cost, more rough approximation for algorithm, as bonus `getTUGuess` work more like gravity/potential than normal cost.
+	if (node->_openIndex < 0)
+	{
+		_heap.push_back(node);
+		node->_openIndex = (int)_heap.size() - 1;
+	}
+	else
+	{
+		assert((size_t)node->_openIndex < _heap.size() && _heap[node->_openIndex] == node);
+	}
+	// cost usually go down, but check both ways to keep heap valid in any case
+	siftUp(node->_openIndex);
+	siftDown(node->_openIndex);
 }
 
 
@@ -17,7 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <queue>
+#include <vector>
 #include <SDL_stdinc.h>
 
 namespace OpenXcom
@@ -25,51 +25,37 @@ namespace OpenXcom
 
 class PathfindingNode;
 
-struct OpenSetEntry
-{
-	PathfindingNode *_node;
-	Sint16 _cost;
-	Uint8 _openentry;
-};
-
 /**
- * Helper class to compare entries through pointers.
- */
-class EntryCompare
-{
-public:
-	/**
-	 * Compares entries @a *a and @a *b.
-	 * @param a Pointer to first entry.
-	 * @param b Pointer to second entry.
-	 * @return True if entry @a *b must come before @a *a.
-	 */
-	bool operator()(const OpenSetEntry& a, const OpenSetEntry& b) const
-	{
-		return b._cost < a._cost;
-	}
-};
-
-/**
- * A class that holds references to the nodes to be examined in pathfinding.
+ * Open set of path search, indexed 4-ary min heap of nodes.
+ * Every node knows its own place in heap, so improving node cost
+ * moves existing entry instead of adding new one and leaving old one behind.
  */
 class PathfindingOpenSet
 {
 public:
+	/// Number of children of each heap entry.
+	static constexpr size_t Arity = 4;
+
 	/// Cleans up the set and frees allocated memory.
 	~PathfindingOpenSet();
 	/// Gets the next node to check.
 	PathfindingNode *pop();
-	/// Adds a node to the set.
+	/// Adds a node to the set or updates its cost.
 	void push(PathfindingNode *node);
+	/// Removes all nodes, keeps allocated memory.
+	void clear() { _heap.clear(); }
 	/// Is the set empty?
-	bool empty() const { return _queue.empty(); }
+	bool empty() const { return _heap.empty(); }
 
 private:
-	std::priority_queue<OpenSetEntry, std::vector<OpenSetEntry>, EntryCompare> _queue;
-
-	/// Removes reachable discarded entries.
-	void removeDiscarded();
+	std::vector<PathfindingNode*> _heap;
+
+	/// Puts node in given place of heap.
+	void place(PathfindingNode *node, size_t index);
+	/// Moves node closer to top of heap.
+	void siftUp(size_t index);
+	/// Moves node closer to bottom of heap.
+	void siftDown(size_t index);
 };
 
 }
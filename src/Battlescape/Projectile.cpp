@@ -601,40 +601,20 @@ int Projectile::calculateThrow(double accuracy)
 }
 
 /**
- * Calculates the new target in voxel space, based on the given accuracy modifier.
+ * Moves the target in voxel space by random spread of vanilla accuracy.
+ * Does not depend on battle state, so it can be used to simulate shots outside of the battle.
+ * @param rng Random state used for rolls.
  * @param origin Start position of the trajectory in voxels.
  * @param target Endpoint of the trajectory in voxels.
- * @param accuracy Accuracy modifier.
- * @param keepRange Whether range affects accuracy.
- * @param extendLine should this line get extended to maximum distance?
+ * @param accuracy Final accuracy of the shot.
+ * @param altThrow Is it throw affected by the alternative grenade mechanic?
  */
-void Projectile::applyAccuracy(Position origin, Position *target, double accuracy, bool keepRange, bool extendLine)
+void Projectile::applySpread(RNG::RandomState& rng, Position origin, Position *target, double accuracy, bool altThrow)
 {
 	int xdiff = origin.x - target->x;
 	int ydiff = origin.y - target->y;
 	int zdiff = origin.z - target->z;
 	double realDistance = sqrt((double)(xdiff*xdiff)+(double)(ydiff*ydiff)+(double)(zdiff*zdiff));
-	// maxRange is the maximum range a projectile shall ever travel in voxel space
-	double maxRange = keepRange?realDistance:16*1000; // 1000 tiles
-	maxRange = _action.type == BA_HIT?46:maxRange; // up to 2 tiles diagonally (as in the case of reaper v reaper)
-
-	if (_action.type != BA_HIT)
-	{
-		int upperLimit, lowerLimit;
-		int dropoff = _action.weapon->getRules()->calculateLimits(upperLimit, lowerLimit, _save->getDepth(), _action.type);
-
-		double distance = realDistance / 16; // distance in tiles, but still fractional
-		double accuracyLoss = 0.0;
-		if (distance > upperLimit)
-		{
-			accuracyLoss = (dropoff * (distance - upperLimit)) / 100;
-		}
-		else if (distance < lowerLimit)
-		{
-			accuracyLoss = (dropoff * (lowerLimit - distance)) / 100;
-		}
-		accuracy = std::max(0.0, accuracy - accuracyLoss);
-	}
 
 	int xDist = abs(origin.x - target->x);
 	int yDist = abs(origin.y - target->y);
@@ -672,42 +652,15 @@ void Projectile::applyAccuracy(Position origin, Position *target, double accurac
 	else
 		zShift = xyShift + zDist / 2;
 
-    // Apply penalty for having no LOS to target
-	int noLOSAccuracyPenalty = _action.weapon->getRules()->getNoLOSAccuracyPenalty(_mod);
-	if (noLOSAccuracyPenalty != -1)
-	{
-		Tile *t = _save->getTile(target->toTile());
-		if (t)
-		{
-			bool hasLOS = false;
-			BattleUnit *bu = _action.actor;
-			BattleUnit *targetUnit = t->getUnit(); // we can call TileEngine::visible() only if the target unit is on the same tile
-
-			if (targetUnit)
-			{
-				hasLOS = _save->getTileEngine()->visible(bu, t);
-			}
-			else
-			{
-				hasLOS = _save->getTileEngine()->isTileInLOS(&_action, t, false);
-			}
-
-			if (!hasLOS)
-			{
-				accuracy = accuracy * noLOSAccuracyPenalty / 100;
-			}
-		}
-	}
-
-	int deviation = RNG::generate(0, 100) - (accuracy * 100);
+	int deviation = rng.generate(0, 100) - (accuracy * 100);
 
 	// Alternative throwing mechanic
-	if (_action.type == BA_THROW && Options::battleAltGrenades)
+	if (altThrow && Options::battleAltGrenades)
 	{
 		int distance = round(realDistance / 16);
 		int maxDistanceWithoutPenalty = sqrt(accuracy * 100) * 3;
 		int penalty = std::max( 0, (distance - maxDistanceWithoutPenalty)*16 );
-		deviation += RNG::generate(0, penalty);
+		deviation += rng.generate(0, penalty);
 
 		if (deviation >= 0)
 			deviation += 30;	// Extra spread to "miss" cloud is like 2 additional tiles maximum
@@ -737,8 +690,8 @@ void Projectile::applyAccuracy(Position origin, Position *target, double accurac
 
 		for (int i = 0; i < 15; ++i) // Break from this cycle when proper target is found
 		{
-			dX = RNG::generate(0, deviation) - deviation / 2;
-			dY = RNG::generate(0, deviation) - deviation / 2;
+			dX = rng.generate(0, deviation) - deviation / 2;
+			dY = rng.generate(0, deviation) - deviation / 2;
 
 			int radiusSq = dX*dX + dY*dY;
 			int deviateRadius = deviation / 2;
@@ -759,27 +712,104 @@ void Projectile::applyAccuracy(Position origin, Position *target, double accurac
 
 	else // Classic shooting spread
 	{
-		target->x += RNG::generate(0, deviation) - deviation / 2;
-		target->y += RNG::generate(0, deviation) - deviation / 2;
+		target->x += rng.generate(0, deviation) - deviation / 2;
+		target->y += rng.generate(0, deviation) - deviation / 2;
+	}
+
+	target->z += rng.generate(0, deviation / 2) / 2 - deviation / 8;
+}
+
+/**
+ * Extends the line from origin through target up to the given range.
+ * @param origin Start position of the trajectory in voxels.
+ * @param target Endpoint of the trajectory in voxels.
+ * @param maxRange Length of the new line in voxels.
+ */
+void Projectile::extendTrajectory(Position origin, Position *target, double maxRange)
+{
+	double rotation, tilt;
+	rotation = atan2(double(target->y - origin.y), double(target->x - origin.x)) * 180 / M_PI;
+	tilt = atan2(double(target->z - origin.z),
+				 sqrt(double(target->x - origin.x)*double(target->x - origin.x)+double(target->y - origin.y)*double(target->y - origin.y))) * 180 / M_PI;
+	// calculate new target
+	// this new target can be very far out of the map, but we don't care about that right now
+	double cos_fi = cos(Deg2Rad(tilt));
+	double sin_fi = sin(Deg2Rad(tilt));
+	double cos_te = cos(Deg2Rad(rotation));
+	double sin_te = sin(Deg2Rad(rotation));
+	target->x = (int)(origin.x + maxRange * cos_te * cos_fi);
+	target->y = (int)(origin.y + maxRange * sin_te * cos_fi);
+	target->z = (int)(origin.z + maxRange * sin_fi);
+}
+
+/**
+ * Calculates the new target in voxel space, based on the given accuracy modifier.
+ * @param origin Start position of the trajectory in voxels.
+ * @param target Endpoint of the trajectory in voxels.
+ * @param accuracy Accuracy modifier.
+ * @param keepRange Whether range affects accuracy.
+ * @param extendLine should this line get extended to maximum distance?
+ */
+void Projectile::applyAccuracy(Position origin, Position *target, double accuracy, bool keepRange, bool extendLine)
+{
+	int xdiff = origin.x - target->x;
+	int ydiff = origin.y - target->y;
+	int zdiff = origin.z - target->z;
+	double realDistance = sqrt((double)(xdiff*xdiff)+(double)(ydiff*ydiff)+(double)(zdiff*zdiff));
+	// maxRange is the maximum range a projectile shall ever travel in voxel space
+	double maxRange = keepRange?realDistance:16*1000; // 1000 tiles
+	maxRange = _action.type == BA_HIT?46:maxRange; // up to 2 tiles diagonally (as in the case of reaper v reaper)
+
+	if (_action.type != BA_HIT)
+	{
+		int upperLimit, lowerLimit;
+		int dropoff = _action.weapon->getRules()->calculateLimits(upperLimit, lowerLimit, _save->getDepth(), _action.type);
+
+		double distance = realDistance / 16; // distance in tiles, but still fractional
+		double accuracyLoss = 0.0;
+		if (distance > upperLimit)
+		{
+			accuracyLoss = (dropoff * (distance - upperLimit)) / 100;
+		}
+		else if (distance < lowerLimit)
+		{
+			accuracyLoss = (dropoff * (lowerLimit - distance)) / 100;
+		}
+		accuracy = std::max(0.0, accuracy - accuracyLoss);
+	}
+
+    // Apply penalty for having no LOS to target
+	int noLOSAccuracyPenalty = _action.weapon->getRules()->getNoLOSAccuracyPenalty(_mod);
+	if (noLOSAccuracyPenalty != -1)
+	{
+		Tile *t = _save->getTile(target->toTile());
+		if (t)
+		{
+			bool hasLOS = false;
+			BattleUnit *bu = _action.actor;
+			BattleUnit *targetUnit = t->getUnit(); // we can call TileEngine::visible() only if the target unit is on the same tile
+
+			if (targetUnit)
+			{
+				hasLOS = _save->getTileEngine()->visible(bu, t);
+			}
+			else
+			{
+				hasLOS = _save->getTileEngine()->isTileInLOS(&_action, t, false);
+			}
+
+			if (!hasLOS)
+			{
+				accuracy = accuracy * noLOSAccuracyPenalty / 100;
+			}
+		}
 	}
 
-	target->z += RNG::generate(0, deviation / 2) / 2 - deviation / 8;
+	applySpread(RNG::globalRandomState(), origin, target, accuracy, _action.type == BA_THROW);
 
 	if (extendLine)
 	{
-		double rotation, tilt;
-		rotation = atan2(double(target->y - origin.y), double(target->x - origin.x)) * 180 / M_PI;
-		tilt = atan2(double(target->z - origin.z),
-					 sqrt(double(target->x - origin.x)*double(target->x - origin.x)+double(target->y - origin.y)*double(target->y - origin.y))) * 180 / M_PI;
-		// calculate new target
-		// this new target can be very far out of the map, but we don't care about that right now
-		double cos_fi = cos(Deg2Rad(tilt));
-		double sin_fi = sin(Deg2Rad(tilt));
-		double cos_te = cos(Deg2Rad(rotation));
-		double sin_te = sin(Deg2Rad(rotation));
-		target->x = (int)(origin.x + maxRange * cos_te * cos_fi);
-		target->y = (int)(origin.y + maxRange * sin_te * cos_fi);
-		target->z = (int)(origin.z + maxRange * sin_fi);
+		extendTrajectory(origin, target, maxRange);
 	}
 
 	if (Options::battleRealisticAccuracy && Options::battleRealisticDisplayRolls && _action.actor->getFaction() == FACTION_PLAYER)
@@ -919,14 +949,14 @@ void Projectile::applyAccuracyRealistic(Position origin, Position* target, doubl
 	int distanceInteger = round(distance);
 	if (distanceInteger < 1) distanceInteger = 1;
 
-	int rawChanceToHit = Projectile::getHitChance(distanceInteger, accuracyInteger, _save->getMod()->getHitChancesTable( targetSize ));
+	int rawChanceToHit = _save->getMod()->getHitChance(targetSize, distanceInteger, accuracyInteger);
 	int coveredChanceToHit = rawChanceToHit;
 
     // Apply exposure
 	if (exposedVoxelsCount > 0 && coverHasEffect)
 	{
-		accuracyInteger = round(100 * (accuracy * coverEfficiencyCoeff * exposure + accuracy * (1 - coverEfficiencyCoeff)));
-		coveredChanceToHit = Projectile::getHitChance(distanceInteger, accuracyInteger, _save->getMod()->getHitChancesTable( targetSize ));
+		accuracyInteger = round(100 * HitChanceTable::applyExposure(accuracy, exposure, coverEfficiencyCoeff));
+		coveredChanceToHit = _save->getMod()->getHitChance(targetSize, distanceInteger, accuracyInteger);
 	}
 
 	if (Options::battleRealisticImprovedAimed && isSniperShot)
@@ -1291,40 +1321,4 @@ void Projectile::addVaporCloud()
 	}
 }
 
-
-/**
- * Calculates chance to hit based on Accuracy and Distance.
- * @param distance Distance to target in tiles.
- * @param accuracy Final accuracy of a shooter.
- */
-int Projectile::getHitChance(int distance, int accuracy, const std::vector<int> *lookupTable)
-{
-	if (!lookupTable) return accuracy;
-
-	int maxAccuracy = Mod::maxAccuracy;
-	int maxDistance = Mod::distanceRows;
-	int accuraciesPerRow = Mod::accPerRowCount;
-
-	if (accuracy < 0) accuracy = 0;
-	if (accuracy > maxAccuracy) accuracy = maxAccuracy;
-	if (distance < 1) distance = 1;
-	if (distance > maxDistance) distance = maxDistance;
-
-	int index;
-	int result;
-
-	if (accuracy % 2 == 0) // For even number - just take the value from table
-	{
-		index = (distance - 1) * accuraciesPerRow + accuracy / 2;
-		result = lookupTable->at( index );
-		return result;
-	}
-
-	// For odd number - interpolate between prev and next even numbers
-	index = (distance - 1) * accuraciesPerRow + (accuracy - 1) / 2;
-	result = Round( ((double)lookupTable->at(index) + (double)lookupTable->at(index+1)) / 2 );
-
-	return result;
-}
-
 }
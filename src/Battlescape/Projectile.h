@@ -24,6 +24,8 @@
 namespace OpenXcom
 {
 
+namespace RNG { class RandomState; }
+
 class BattleItem;
 class SavedBattleGame;
 class Surface;
@@ -44,6 +46,10 @@ public:
 	static Position getPositionFromStart(const std::vector<Position>& trajectory, int pos);
 	/// Get Position at offset from end from trajectory vector.
 	static Position getPositionFromEnd(const std::vector<Position>& trajectory, int pos);
+	/// Applies random spread of vanilla accuracy to target.
+	static void applySpread(RNG::RandomState& rng, Position origin, Position *target, double accuracy, bool altThrow);
+	/// Extends line from origin through target to given range.
+	static void extendTrajectory(Position origin, Position *target, double maxRange);
 
 private:
 	Mod *_mod;
@@ -95,9 +101,6 @@ private:
 	bool isReversed() const;
 	/// adds a cloud of particles at the projectile's location
 	void addVaporCloud();
-
-	/// converts Accuracy to Chance to hit
-    static int getHitChance(int distance, int accuracy, const std::vector<int>* lookupTable);
 };
 
 }
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include "ReachabilityCache.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates empty cache.
+ */
+ReachabilityCache::ReachabilityCache()
+{
+
+}
+
+/**
+ * Cleans up the cache.
+ */
+ReachabilityCache::~ReachabilityCache()
+{
+
+}
+
+/**
+ * Removes field from cache, order of fields is not preserved.
+ * @param index Index of field.
+ */
+void ReachabilityCache::erase(size_t index)
+{
+	_nodesCount -= _fields[index].nodes.size();
+	if (index + 1 != _fields.size())
+	{
+		_fields[index] = std::move(_fields.back());
+	}
+	_fields.pop_back();
+}
+
+/**
+ * Finds flood with given key.
+ * @param key Inputs of flood.
+ * @return Stored flood or null.
+ */
+const ReachabilityCache::Field *ReachabilityCache::find(const ReachabilityKey &key)
+{
+	for (auto& field : _fields)
+	{
+		if (field.key == key)
+		{
+			field.lastUse = ++_useCounter;
+			++_hits;
+			return &field;
+		}
+	}
+	++_misses;
+	return nullptr;
+}
+
+/**
+ * Stores flood, if there are too many nodes stored then least recently used floods are dropped.
+ * @param key Inputs of flood.
+ * @param reachable Nodes reached by flood, in order returned to caller.
+ * @param ranOutOfTUs Did flood run out of TUs.
+ */
+void ReachabilityCache::store(const ReachabilityKey &key, const std::vector<PathfindingNode*> &reachable, bool ranOutOfTUs)
+{
+	if (reachable.size() > MaxNodes)
+	{
+		return;
+	}
+	while (!_fields.empty() && _nodesCount + reachable.size() > MaxNodes)
+	{
+		auto oldest = std::min_element(_fields.begin(), _fields.end(), [](const Field& a, const Field& b){ return a.lastUse < b.lastUse; });
+		erase(oldest - _fields.begin());
+	}
+
+	Field field;
+	field.key = key;
+	field.ranOutOfTUs = ranOutOfTUs;
+	field.lastUse = ++_useCounter;
+	field.nodes.reserve(reachable.size());
+	for (auto* pn : reachable)
+	{
+		ReachabilityNode node;
+		node.pos = pn->getPosition();
+		node.cost = pn->getTUCost(false);
+		if (pn->getPrevNode())
+		{
+			node.prevPos = pn->getPrevNode()->getPosition();
+			node.prevDir = pn->getPrevDir();
+			node.hasPrev = true;
+		}
+		if (field.nodes.empty())
+		{
+			field.minX = field.maxX = node.pos.x;
+			field.minY = field.maxY = node.pos.y;
+		}
+		field.minX = std::min(field.minX, (int)node.pos.x);
+		field.maxX = std::max(field.maxX, (int)node.pos.x);
+		field.minY = std::min(field.minY, (int)node.pos.y);
+		field.maxY = std::max(field.maxY, (int)node.pos.y);
+		field.nodes.push_back(node);
+	}
+	// big units and walls of neighbour tiles are checked from tiles on edge of flood
+	field.minX -= Margin;
+	field.minY -= Margin;
+	field.maxX += Margin + 1;
+	field.maxY += Margin + 1;
+
+	_nodesCount += field.nodes.size();
+	_fields.push_back(std::move(field));
+}
+
+/**
+ * Drops floods that could be affected by change in given area.
+ * @param tileA First corner of area.
+ * @param tileB Second corner of area.
+ */
+void ReachabilityCache::invalidate(Position tileA, Position tileB)
+{
+	const int minX = std::min(tileA.x, tileB.x);
+	const int maxX = std::max(tileA.x, tileB.x);
+	const int minY = std::min(tileA.y, tileB.y);
+	const int maxY = std::max(tileA.y, tileB.y);
+	for (size_t i = 0; i < _fields.size();)
+	{
+		const Field& field = _fields[i];
+		if (maxX >= field.minX && minX <= field.maxX && maxY >= field.minY && minY <= field.maxY)
+		{
+			erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+/**
+ * Drops all floods.
+ */
+void ReachabilityCache::flush()
+{
+	_fields.clear();
+	_nodesCount = 0;
+}
+
+}
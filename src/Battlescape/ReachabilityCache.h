@@ -0,0 +1,145 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+#include "PathfindingNode.h"
+#include "../Mod/MapData.h"
+
+namespace OpenXcom
+{
+
+class BattleUnit;
+class Armor;
+
+/**
+ * All inputs that decide result of reachability flood.
+ */
+struct ReachabilityKey
+{
+	/// Unit that moves, its own tiles are passable only for it.
+	const BattleUnit *unit = nullptr;
+	/// Current position of unit.
+	Position unitPosition;
+	/// Start of flood.
+	Position start;
+	/// Armor of unit, define size and move costs.
+	const Armor *armor = nullptr;
+	/// Movement type of unit.
+	MovementType movementType = MT_WALK;
+	/// Faction of unit.
+	int faction = 0;
+	/// Hash of units that unit know about.
+	Uint64 knownUnits = 0;
+	/// Target of missile.
+	const BattleUnit *missileTarget = nullptr;
+	/// Limit of TU and energy.
+	PathfindingCost costMax;
+	/// Limit of returned tiles when searching entire map.
+	int maxTilesToReturn = 0;
+	/// Kind of move.
+	int bam = 0;
+	/// Flood entire map.
+	bool entireMap = false;
+	/// Result is stored in alternative nodes.
+	bool alternate = false;
+	/// Units of same faction are ignored.
+	bool ignoreFriends = false;
+
+	bool operator==(const ReachabilityKey& other) const
+	{
+		return unit == other.unit && unitPosition == other.unitPosition && start == other.start && armor == other.armor
+			&& movementType == other.movementType && faction == other.faction && knownUnits == other.knownUnits
+			&& missileTarget == other.missileTarget && costMax.time == other.costMax.time && costMax.energy == other.costMax.energy
+			&& maxTilesToReturn == other.maxTilesToReturn && bam == other.bam && entireMap == other.entireMap
+			&& alternate == other.alternate && ignoreFriends == other.ignoreFriends;
+	}
+};
+
+/**
+ * One node of stored flood.
+ */
+struct ReachabilityNode
+{
+	Position pos;
+	Position prevPos;
+	PathfindingCost cost;
+	Sint8 prevDir = 0;
+	bool hasPrev = false;
+};
+
+/**
+ * Turn scoped store of reachability floods done by `Pathfinding::findReachablePathFindingNodes`.
+ * AI asks many times for same floods (own unit on each think, enemies for each alien),
+ * result is reused until a unit moves or terrain changes near area covered by flood.
+ */
+class ReachabilityCache
+{
+public:
+	/// How far from reached tiles flood could look for terrain or units.
+	static constexpr int Margin = 2;
+	/// Limit of stored nodes in all floods.
+	static constexpr size_t MaxNodes = 1 << 20;
+
+	/**
+	 * Stored flood.
+	 */
+	struct Field
+	{
+		ReachabilityKey key;
+		std::vector<ReachabilityNode> nodes;
+		int minX = 0, minY = 0, maxX = -1, maxY = -1;
+		bool ranOutOfTUs = false;
+		Uint64 lastUse = 0;
+	};
+
+private:
+	std::vector<Field> _fields;
+	size_t _nodesCount = 0;
+	Uint64 _useCounter = 0;
+	Uint64 _hits = 0, _misses = 0;
+
+	/// Removes field from cache.
+	void erase(size_t index);
+
+public:
+	/// Creates empty cache.
+	ReachabilityCache();
+	/// Cleans up the cache.
+	~ReachabilityCache();
+
+	/// Finds flood with given key.
+	const Field *find(const ReachabilityKey &key);
+	/// Stores flood.
+	void store(const ReachabilityKey &key, const std::vector<PathfindingNode*> &reachable, bool ranOutOfTUs);
+	/// Drops floods that could be affected by change in area.
+	void invalidate(Position tileA, Position tileB);
+	/// Drops all floods.
+	void flush();
+
+	/// Gets number of successful finds.
+	Uint64 getHits() const { return _hits; }
+	/// Gets number of failed finds.
+	Uint64 getMisses() const { return _misses; }
+	/// Resets statistic of finds.
+	void resetStats() { _hits = 0; _misses = 0; }
+};
+
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cmath>
+#include "TargetingPreview.h"
+#include "TileEngine.h"
+#include "BattlescapeGame.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/BattleItem.h"
+#include "../Savegame/Tile.h"
+#include "../Mod/Mod.h"
+#include "../Mod/Armor.h"
+#include "../Mod/RuleItem.h"
+#include "../Mod/RuleDamageType.h"
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Compares all fields of key.
+ */
+bool TargetingPreview::Key::operator==(const Key& other) const
+{
+	return cursor == other.cursor && actor == other.actor && target == other.target && weapon == other.weapon && ammo == other.ammo
+		&& type == other.type && firingAccuracy == other.firingAccuracy && targetHeight == other.targetHeight && revision == other.revision
+		&& kneeled == other.kneeled && spray == other.spray && targetVisible == other.targetVisible && debugMode == other.debugMode && offCentre == other.offCentre;
+}
+
+/**
+ * Creates empty preview.
+ * @param save Pointer to battle.
+ * @param mod Pointer to mod.
+ */
+TargetingPreview::TargetingPreview(SavedBattleGame *save, Mod *mod) : _save(save), _mod(mod), _valid(false)
+{
+
+}
+
+/**
+ * Cleans up the preview.
+ */
+TargetingPreview::~TargetingPreview()
+{
+
+}
+
+/**
+ * Gets hit chance of current action at cursor.
+ * Terrain revision of tile engine change each time any unit moves or terrain changes, so it covers state of battle.
+ * @param action Current action of selected unit.
+ * @param cursor Position of cursor.
+ * @param unit Unit under cursor, can be null.
+ * @param tile Tile under cursor.
+ * @return Hit chance, valid until next call.
+ */
+const TargetingPreviewResult &TargetingPreview::get(BattleAction *action, Position cursor, BattleUnit *unit, Tile *tile)
+{
+	auto attack = BattleActionAttack::GetBeforeShoot(*action);
+
+	Key key;
+	key.cursor = cursor;
+	key.actor = action->actor;
+	key.target = unit;
+	key.weapon = action->weapon;
+	key.ammo = attack.damage_item;
+	key.type = action->type;
+	key.firingAccuracy = BattleUnit::getFiringAccuracy(attack, _mod);
+	key.targetHeight = unit ? unit->getHeight() + unit->getFloatHeight() : 0;
+	key.revision = _save->getTileEngine()->getTerrainRevision();
+	key.kneeled = action->actor->isKneeled();
+	key.spray = action->sprayTargeting;
+	key.targetVisible = unit && unit->getVisible();
+	key.debugMode = _save->getDebugMode();
+	key.offCentre = Options::oxceEnableOffCentreShooting;
+
+	if (!_valid || !(key == _key))
+	{
+		_key = key;
+		calculate(action, cursor, unit, tile);
+		_valid = true;
+	}
+	return _result;
+}
+
+/**
+ * Computes hit chance from scratch, scanning exposure of target from every shooting origin.
+ * @param action Current action of selected unit.
+ * @param cursor Position of cursor.
+ * @param unit Unit under cursor, can be null.
+ * @param tile Tile under cursor.
+ */
+void TargetingPreview::calculate(BattleAction *action, Position cursor, BattleUnit *unit, Tile *tile)
+{
+	_result = TargetingPreviewResult{};
+
+	const RuleItem *weapon = action->weapon->getRules();
+	auto attack = BattleActionAttack::GetBeforeShoot(*action);
+	BattleUnit* shooterUnit = action->actor;
+	const Mod::AccuracyModConfig *AccuracyMod = _mod->getAccuracyModConfig();
+	int distanceVoxels = 0;
+	int targetSize = 1;
+
+	auto* ammo = attack.damage_item;
+	const RuleItem *ammoRule = (ammo != nullptr) ? ammo->getRules() : nullptr;
+
+	bool isShotgun = ammoRule && ammoRule->getShotgunPellets() != 0 && ammoRule->getDamageType()->isDirect();
+	bool isArcingShot = action->weapon->getArcingShot(action->type);
+	bool isSpray = action->sprayTargeting;
+	_result.disableRA = isShotgun || isArcingShot || isSpray;
+
+	if (unit && unit == shooterUnit)
+	{
+		_result.targetSelf = true;
+		return;
+	}
+
+	Tile *targetTile = nullptr;
+	std::vector<Position> exposedVoxels;
+
+	if (unit && unit->getVisible()) // Targeting a unit
+	{
+		targetSize = unit->getArmor()->getSize();
+		targetTile = unit->getTile();
+		exposedVoxels.reserve((1 + BattleUnit::BIG_MAX_RADIUS * 2) * TileEngine::voxelTileSize.z / 2);
+
+		// This is needed inside getOriginVoxel() to get direction
+		action->target = unit->getPosition();
+
+		Position selectedOrigin = TileEngine::invalid;
+		std::vector<BattleActionOrigin> originTypes;
+		originTypes.push_back(BattleActionOrigin::CENTRE);
+		if (Options::oxceEnableOffCentreShooting)
+		{
+			originTypes.push_back(BattleActionOrigin::LEFT);
+			originTypes.push_back(BattleActionOrigin::RIGHT);
+		}
+
+		// Find shooting point with best target's exposure
+		for (const auto &relPos : originTypes)
+		{
+			exposedVoxels.clear();
+			action->relativeOrigin = relPos;
+			Position origin = _save->getTileEngine()->getOriginVoxel(*action, shooterUnit->getTile());
+			double exposure = _save->getTileEngine()->checkVoxelExposure(&origin, targetTile, shooterUnit, false, &exposedVoxels, nullptr, false);
+
+			// Save default values for center origin
+			// Overwrite if better results are found for shifted origins
+			if (relPos == BattleActionOrigin::CENTRE || (int)exposedVoxels.size() > _result.maxVoxels)
+			{
+				selectedOrigin = origin;
+				_result.maxVoxels = exposedVoxels.size();
+				_result.maxExposure = exposure;
+			}
+		}
+		action->relativeOrigin = BattleActionOrigin::CENTRE; // Reset to default! It's used elsewhere
+		distanceVoxels = unit->distance3dToPositionPrecise(selectedOrigin) - shooterUnit->getRadiusVoxels();
+	}
+	else if (shooterUnit->getTile()) // Targeting an empty tile
+	{
+		action->relativeOrigin = BattleActionOrigin::CENTRE;
+		action->target = cursor;
+		Position targetPos = action->target.toVoxel();
+		Position origin = _save->getTileEngine()->getOriginVoxel(*action, shooterUnit->getTile());
+		targetTile = _save->getTile(action->target);
+		bool isPlayer = (shooterUnit->getFaction() == FACTION_PLAYER);
+		targetPos = _save->getTileEngine()->adjustTargetVoxelFromTileType(&origin, targetTile, shooterUnit, isPlayer);
+		distanceVoxels = Position::distance(origin, targetPos) - shooterUnit->getRadiusVoxels();
+	}
+
+	double accuracy = static_cast<double>(_key.firingAccuracy);
+	double distanceFloat = (double)distanceVoxels / Position::TileXY;
+
+	int upperLimit, lowerLimit;
+	int dropoff = weapon->calculateLimits(upperLimit, lowerLimit, _save->getDepth(), action->type);
+
+	_result.rating = TPR_ADJUSTED;
+	if (distanceFloat > upperLimit)
+	{
+		accuracy -= (distanceFloat - upperLimit) * dropoff;
+	}
+	else if (distanceFloat < lowerLimit)
+	{
+		accuracy -= (lowerLimit - distanceFloat) * dropoff;
+	}
+	else
+	{
+		_result.rating = TPR_OPTIMAL;
+	}
+
+	int noLOSAccuracyPenalty = weapon->getNoLOSAccuracyPenalty(_mod);
+	if (noLOSAccuracyPenalty != -1)
+	{
+		bool hasLOS = false;
+		if (unit && (unit->getVisible() || _save->getDebugMode()))
+		{
+			hasLOS = _save->getTileEngine()->visible(action->actor, tile);
+		}
+		else
+		{
+			hasLOS = _save->getTileEngine()->isTileInLOS(action, tile, false);
+		}
+
+		if (!hasLOS)
+		{
+			accuracy *= (double)noLOSAccuracyPenalty / 100.0;
+			_result.rating = TPR_ADJUSTED;
+		}
+	}
+
+	int snipingBonus = (round(accuracy) > 100 ? round((accuracy - 100) / 2) : 0);
+	bool isSniperShot = (snipingBonus > 0  && !_result.disableRA);
+
+	bool coverHasEffect = AccuracyMod->coverEfficiency[(int)Options::battleRealisticCoverEfficiency];
+	if (unit && _result.maxVoxels > 0 && coverHasEffect && !_result.disableRA)
+	{
+		// Apply the exposure
+		double coverEfficiencyCoeff = AccuracyMod->coverEfficiency[(int)Options::battleRealisticCoverEfficiency] / 100.0;
+		accuracy = HitChanceTable::applyExposure(accuracy, _result.maxExposure, coverEfficiencyCoeff);
+	}
+
+	int accuracyInteger = round(accuracy);
+	int distance = round(distanceFloat);
+	if (distance < 1) distance = 1;
+
+	accuracyInteger = _mod->getHitChance(targetSize, distance, accuracyInteger);
+
+	if (Options::battleRealisticImprovedAimed && isSniperShot)
+	{
+		accuracyInteger += snipingBonus;
+	}
+
+	int distanceSq = action->actor->distance3dToPositionSq(cursor);
+	bool outOfRange = weapon->isOutOfRange(distanceSq);
+
+	if (isSniperShot)
+	{
+		_result.rating = TPR_SNIPER;
+	}
+
+	if (outOfRange)
+	{
+		accuracyInteger = 0;
+		_result.rating = TPR_BLOCKED;
+	}
+	else if (unit && (unit->getVisible() || _save->getDebugMode()) && _result.maxVoxels == 0)
+	{
+		_result.rating = TPR_BLOCKED;
+	}
+
+	_result.accuracy = accuracyInteger;
+}
+
+}
@@ -0,0 +1,115 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <SDL_types.h>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+class SavedBattleGame;
+class Mod;
+class BattleUnit;
+class BattleItem;
+class Tile;
+struct BattleAction;
+enum BattleActionType : Uint8;
+
+/**
+ * Kind of hit chance shown on cursor, each one is drawn with its own color.
+ */
+enum TargetingPreviewRating : Uint8
+{
+	TPR_ADJUSTED,
+	TPR_OPTIMAL,
+	TPR_SNIPER,
+	TPR_BLOCKED,
+};
+
+/**
+ * Hit chance of shot at cursor with realistic accuracy.
+ */
+struct TargetingPreviewResult
+{
+	/// Chance to hit in percent.
+	int accuracy = 0;
+	/// How accuracy was adjusted.
+	TargetingPreviewRating rating = TPR_ADJUSTED;
+	/// Shooter aims at itself, nothing is shown.
+	bool targetSelf = false;
+	/// Weapon ignores realistic accuracy (shotguns, arcing shots, spray).
+	bool disableRA = false;
+	/// Best exposure of target unit from all shooting origins.
+	double maxExposure = 0.0;
+	/// Number of exposed voxels of target unit from best origin.
+	int maxVoxels = 0;
+};
+
+/**
+ * Computes realistic accuracy hit chance shown on aim cursor.
+ * Exposure scans from every shooting origin are costly, so result is kept until cursor tile,
+ * shooter, stance, weapon, fire mode or state of battle change, all other frames only draw it.
+ */
+class TargetingPreview
+{
+	/**
+	 * Helper struct with everything that result depends on.
+	 */
+	struct Key
+	{
+		Position cursor;
+		const BattleUnit *actor = nullptr;
+		const BattleUnit *target = nullptr;
+		const BattleItem *weapon = nullptr;
+		const BattleItem *ammo = nullptr;
+		BattleActionType type = {};
+		int firingAccuracy = 0;
+		int targetHeight = 0;
+		Uint32 revision = 0;
+		bool kneeled = false;
+		bool spray = false;
+		bool targetVisible = false;
+		bool debugMode = false;
+		bool offCentre = false;
+
+		bool operator==(const Key& other) const;
+	};
+
+	SavedBattleGame *_save;
+	Mod *_mod;
+	Key _key;
+	TargetingPreviewResult _result;
+	bool _valid;
+
+	/// Computes hit chance from scratch.
+	void calculate(BattleAction *action, Position cursor, BattleUnit *unit, Tile *tile);
+
+public:
+	/// Creates empty preview.
+	TargetingPreview(SavedBattleGame *save, Mod *mod);
+	/// Cleans up the preview.
+	~TargetingPreview();
+
+	/// Gets hit chance of current action at cursor, computed again only when something changed.
+	const TargetingPreviewResult &get(BattleAction *action, Position cursor, BattleUnit *unit, Tile *tile);
+	/// Forgets stored result.
+	void invalidate() { _valid = false; }
+};
+
+}
@@ -39,8 +39,10 @@
 #include "../Mod/Armor.h"
 #include "../Mod/RuleSkill.h"
 #include "../Engine/Options.h"
+#include "../Engine/PhaseTimer.h"
 #include "ProjectileFlyBState.h"
 #include "MeleeAttackBState.h"
+#include "LineHelper.h"
 #include "../fmath.h"
 
 namespace OpenXcom
@@ -48,116 +50,6 @@ namespace OpenXcom
 namespace
 {
 
-/**
- * Calculates a line trajectory, using bresenham algorithm in 3D.
- * @param origin Origin.
- * @param target Target.
- * @param posFunc Function call for each step in primary direction of line.
- * @param driftFunc Function call for each side step of line.
- */
-template<typename FuncNewPosition, typename FuncDrift>
-bool calculateLineHelper(const Position& origin, const Position& target, FuncNewPosition posFunc, FuncDrift driftFunc)
-{
-	int x, x0, x1, delta_x, step_x;
-	int y, y0, y1, delta_y, step_y;
-	int z, z0, z1, delta_z, step_z;
-	int swap_xy, swap_xz;
-	int drift_xy, drift_xz;
-	int cx, cy, cz;
-
-	//start and end points
-	x0 = origin.x;	 x1 = target.x;
-	y0 = origin.y;	 y1 = target.y;
-	z0 = origin.z;	 z1 = target.z;
-
-	//'steep' xy Line, make longest delta x plane
-	swap_xy = abs(y1 - y0) > abs(x1 - x0);
-	if (swap_xy)
-	{
-		std::swap(x0, y0);
-		std::swap(x1, y1);
-	}
-
-	//do same for xz
-	swap_xz = abs(z1 - z0) > abs(x1 - x0);
-	if (swap_xz)
-	{
-		std::swap(x0, z0);
-		std::swap(x1, z1);
-	}
-
-	//delta is Length in each plane
-	delta_x = abs(x1 - x0);
-	delta_y = abs(y1 - y0);
-	delta_z = abs(z1 - z0);
-
-	//drift controls when to step in 'shallow' planes
-	//starting value keeps Line centred
-	drift_xy  = (delta_x / 2);
-	drift_xz  = (delta_x / 2);
-
-	//direction of line
-	step_x = 1;  if (x0 > x1) {  step_x = -1; }
-	step_y = 1;  if (y0 > y1) {  step_y = -1; }
-	step_z = 1;  if (z0 > z1) {  step_z = -1; }
-
-	//starting point
-	y = y0;
-	z = z0;
-
-	//step through longest delta (which we have swapped to x)
-	for (x = x0; ; x += step_x)
-	{
-		//copy position
-		cx = x;	cy = y;	cz = z;
-
-		//unswap (in reverse)
-		if (swap_xz) std::swap(cx, cz);
-		if (swap_xy) std::swap(cx, cy);
-		if (posFunc(Position(cx, cy, cz)))
-		{
-			return true;
-		}
-
-		if (x == x1) break;
-
-		//update progress in other planes
-		drift_xy = drift_xy - delta_y;
-		drift_xz = drift_xz - delta_z;
-
-		//step in y plane
-		if (drift_xy < 0)
-		{
-			y = y + step_y;
-			drift_xy = drift_xy + delta_x;
-
-			cx = x;	cz = z; cy = y;
-			if (swap_xz) std::swap(cx, cz);
-			if (swap_xy) std::swap(cx, cy);
-			if (driftFunc(Position(cx, cy, cz)))
-			{
-				return true;
-			}
-		}
-
-		//same in z
-		if (drift_xz < 0)
-		{
-			z = z + step_z;
-			drift_xz = drift_xz + delta_x;
-
-			cx = x;	cz = z; cy = y;
-			if (swap_xz) std::swap(cx, cz);
-			if (swap_xy) std::swap(cx, cy);
-			if (driftFunc(Position(cx, cy, cz)))
-			{
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
 template<typename FuncNewPosition>
 bool calculateParabolaHelper(const Position& origin, const Position& target, double curvature, const Position& delta, FuncNewPosition posFunc)
 {
@@ -868,14 +760,19 @@ constexpr Position TileEngine::voxelTileCenter;
  * @param maxDarknessToSeeUnits Threshold of darkness for LoS calculation.
  */
 TileEngine::TileEngine(SavedBattleGame *save, Mod *mod) :
-	_save(save), _voxelData(mod->getVoxelData()), _inventorySlotGround(mod->getInventoryGround()), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
+	_save(save), _voxelData(mod->getVoxelData()), _voxelOccupancy(save, mod->getVoxelData()), _inventorySlotGround(mod->getInventoryGround()), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
 	_maxViewDistance(mod->getMaxViewDistance()), _maxViewDistanceSq(_maxViewDistance * _maxViewDistance),
 	_maxVoxelViewDistance(_maxViewDistance * 16), _maxDarknessToSeeUnits(mod->getMaxDarknessToSeeUnits()),
 	_maxStaticLightDistance(mod->getMaxStaticLightDistance()), _maxDynamicLightDistance(mod->getMaxDynamicLightDistance()),
 	_enhancedLighting(mod->getEnhancedLighting())
 {
 	_blockVisibility.resize(save->getMapSizeXYZ());
+	_voxelOccupancy.rebuild();
+	_visibilityMemo.init(save->getMapSizeX(), save->getMapSizeY());
+	_unitGrid.init(save->getMapSizeX(), save->getMapSizeY());
+	_lightSourceCache.init(save->getMapSizeX(), save->getMapSizeY());
 	_cacheTilePos = invalid;
+	_reactionFovPosition = invalid;
 
 	if (Options::oxceTogglePersonalLightType == 2)
 	{
@@ -1095,6 +992,8 @@ void TileEngine::calculateUnitLighting(MapSubset gs)
 
 void TileEngine::calculateLighting(LightLayers layer, Position position, int eventRadius, bool terrianChanged)
 {
+	++_viewRevision;
+	_lightSourceCache.beginPass();
 	auto gsDynamic = MapSubset{ _save->getMapSizeX(), _save->getMapSizeY() };
 	auto gsStatic = gsDynamic;
 
@@ -1116,6 +1015,7 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 				const auto mapData = tile->getMapData(O_OBJECT);
 				auto &cache = _blockVisibility[index];
 
+				_visibilityMemo.invalidate(currPos);
 				cache = {};
 				cache.height = -tile->getTerrainLevel();
 				if (mapData)
@@ -1152,6 +1052,27 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 		);
 	}
 
+	// cached sources depend on terrain and on lower layers that are recalculated now
+	if (position == invalid)
+	{
+		if (terrianChanged)
+		{
+			_lightSourceCache.flush();
+		}
+		else
+		{
+			_lightSourceCache.invalidate(layer + 1, Position(0, 0, 0), std::max(_save->getMapSizeX(), _save->getMapSizeY()));
+		}
+	}
+	else
+	{
+		if (terrianChanged)
+		{
+			_lightSourceCache.invalidate(LL_FIRE, position, eventRadius + 1);
+		}
+		_lightSourceCache.invalidate(layer + 1, position, eventRadius + (layer <= LL_FIRE ? std::max(getMaxStaticLightDistance(), getMaxDynamicLightDistance()) : getMaxDynamicLightDistance()));
+	}
+
 	if (layer <= LL_FIRE)
 	{
 		iterateTiles(
@@ -1181,6 +1102,8 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 
 /**
  * Adds circular light pattern starting from center and losing power with distance travelled.
+ * Tiles lit by source are reused from cache when nothing changed in its range.
+ * @param gs Part of map that is updated.
  * @param center Center.
  * @param power Power.
  * @param layer Light is separated in 4 layers: Ambient, Tiles, Items, Units.
@@ -1191,7 +1114,47 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 	{
 		return;
 	}
+	const auto area = MapSubset::intersection(gs, mapArea(center, power - 1));
+	if (!area)
+	{
+		return;
+	}
 
+	const auto* tiles = _lightSourceCache.find(center, power, layer, area);
+	if (!tiles)
+	{
+		auto& buffer = _lightSourceCache.store(center, power, layer, area);
+		calculateLightContribution(area, center, power, layer, buffer);
+		tiles = &buffer;
+	}
+	for (const auto& lit : *tiles)
+	{
+		// cached area can be bigger than one updated now
+		if (lit.pos.x >= area.beg_x && lit.pos.x < area.end_x && lit.pos.y >= area.beg_y && lit.pos.y < area.end_y)
+		{
+			Tile* tile = _save->getTile(lit.pos);
+			const auto targetLight = tile->getLightMulti(layer);
+			const auto currLight = lit.getLight(targetLight);
+			if (currLight > targetLight)
+			{
+				tile->addLight(currLight, layer);
+			}
+		}
+	}
+}
+
+/**
+ * Traces all tiles lit by one light source.
+ * Rays are only stopped by light of lower layers, light of same layer is applied later by `addLight`,
+ * so result does not depend on order of sources and can be reused.
+ * @param gs Part of map to trace.
+ * @param center Center.
+ * @param power Power.
+ * @param layer Light layer of source.
+ * @param tiles Lit tiles with light of both rays.
+ */
+void TileEngine::calculateLightContribution(MapSubset gs, Position center, int power, LightLayers layer, std::vector<LightContribution>& tiles)
+{
 	const auto fire = layer == LL_FIRE;
 	const auto items = layer == LL_ITEMS;
 	const auto units = layer == LL_UNITS;
@@ -1208,13 +1171,13 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 
 	iterateTiles(
 		_save,
-		MapSubset::intersection(gs, mapArea(center, power - 1)),
+		gs,
 		[&](Tile* tile)
 		{
 			const auto target = tile->getPosition();
 			const auto diff = target - center;
 			const auto distance = (int)Round(Position::distance(target.toVoxel(), center.toVoxel()) / Position::TileXY);
-			const auto targetLight = tile->getLightMulti(layer);
+			const auto targetLight = tile->getLightMulti((LightLayers)(layer - 1));
 			auto currLight = power - distance;
 
 			if (currLight <= targetLight)
@@ -1223,7 +1186,7 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 			}
 			if (clasicLighting)
 			{
-				tile->addLight(currLight, layer);
+				tiles.push_back(LightContribution{ target, (Uint8)currLight, (Uint8)currLight });
 				return;
 			}
 
@@ -1317,7 +1280,7 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 			currLight = (lightA + lightB) / 2;
 			if (currLight > targetLight)
 			{
-				tile->addLight(currLight, layer);
+				tiles.push_back(LightContribution{ target, (Uint8)lightA, (Uint8)lightB });
 			}
 		}
 	);
@@ -1392,6 +1355,7 @@ inline bool TileEngine::inEventVisibilitySector(const Position &toCheck) const
 */
 bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos, const int eventRadius)
 {
+	PhaseTimer::Scope phaseScope(TP_FOV);
 	size_t oldNumVisibleUnits = unit->getUnitsSpottedThisTurn().size();
 	bool useTurretDirection = false;
 	if (Options::strafe && (unit->getTurretType() > -1)) {
@@ -1511,6 +1475,7 @@ bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos,
 */
 void TileEngine::calculateTilesInFOV(BattleUnit* unit, const Position eventPos, const int eventRadius)
 {
+	PhaseTimer::Scope phaseScope(TP_FOV);
 	bool useTurretDirection = false;
 	bool skipNarrowArcTest = false;
 	int direction;
@@ -1546,7 +1511,6 @@ void TileEngine::calculateTilesInFOV(BattleUnit* unit, const Position eventPos,
 
 	// Variables for finding the tiles to test based on the view direction.
 	Position posTest;
-	std::vector<Position> _trajectory;
 	bool swap = (direction == 0 || direction == 4);
 	const int signX[8] = {+1, +1, +1, +1, -1, -1, -1, -1};
 	const int signY[8] = {-1, -1, -1, +1, +1, +1, -1, -1};
@@ -1560,7 +1524,8 @@ void TileEngine::calculateTilesInFOV(BattleUnit* unit, const Position eventPos,
 			++posSelf.z;
 		}
 	}
-	// Test all tiles within view cone for visibility.
+	// Find all tiles within view cone that need be tested for visibility.
+	std::vector<Position> targets;
 	for (int x = 0; x <= getMaxViewDistance(); ++x) // TODO: Possible improvement: find the intercept points of the arc at max view distance and choose a more intelligent sweep of values when an event arc is defined.
 	{
 		if (direction & 1)
@@ -1589,52 +1554,99 @@ void TileEngine::calculateTilesInFOV(BattleUnit* unit, const Position eventPos,
 
 						if (_save->getTile(posTest)) // inside map?
 						{
-							// this sets tiles to discovered if they are in LOS - tile visibility is not calculated in voxelspace but in tilespace
-							// large units have "4 pair of eyes"
-							int size = unit->getArmor()->getSize();
-							for (int xo = 0; xo < size; xo++)
-							{
-								for (int yo = 0; yo < size; yo++)
-								{
-									Position poso = posSelf + Position(xo, yo, 0);
-									_trajectory.clear();
-									int tst = calculateLineTile(poso, posTest, _trajectory);
-									if (tst > 127)
-									{
-										// Vision impacted something before reaching posTest. Throw away the impact point.
-										_trajectory.pop_back();
-									}
-									// Reveal all tiles along line of vision. Note: needed due to width of bresenham stroke.
-									for (const auto& posVisited : _trajectory)
-									{
-										// Add tiles to the visible list only once. BUT we still need to calculate the whole trajectory as
-										//  this bresenham line's period might be different from the one that originally revealed the tile.
-										if (!unit->hasVisibleTile(_save->getTile(posVisited)))
-										{
-											unit->addToVisibleTiles(_save->getTile(posVisited));
-											if (unit->getFaction() == FACTION_PLAYER)
-											{
-												_save->getTile(posVisited)->setVisible(+1);
-												_save->getTile(posVisited)->setDiscovered(true, O_FLOOR);
-
-												// walls to the east or south of a visible tile, we see that too
-												Tile* t = _save->getTile(Position(posVisited.x + 1, posVisited.y, posVisited.z));
-												if (t)
-													t->setDiscovered(true, O_WESTWALL);
-												t = _save->getTile(Position(posVisited.x, posVisited.y + 1, posVisited.z));
-												if (t)
-													t->setDiscovered(true, O_NORTHWALL);
-											}
-										}
-									}
-								}
-							}
+							targets.push_back(posTest);
 						}
 					}
 				}
 			}
 		}
 	}
+
+	// this sets tiles to discovered if they are in LOS - tile visibility is not calculated in voxelspace but in tilespace
+	// large units have "4 pair of eyes"
+	const int size = unit->getArmor()->getSize();
+	reserveTilesInFOV(size);
+	std::vector<Tile*> visibleTiles;
+	for (int xo = 0; xo < size; xo++)
+	{
+		for (int yo = 0; yo < size; yo++)
+		{
+			visibleTiles.clear();
+			traceTilesInFOV(posSelf + Position(xo, yo, 0), targets, visibleTiles, _rayFanMarks);
+			for (auto* tileVisited : visibleTiles)
+			{
+				// Add tiles to the visible list only once.
+				if (!unit->hasVisibleTile(tileVisited))
+				{
+					unit->addToVisibleTiles(tileVisited);
+					if (unit->getFaction() == FACTION_PLAYER)
+					{
+						const Position posVisited = tileVisited->getPosition();
+						tileVisited->setVisible(+1);
+						tileVisited->setDiscovered(true, O_FLOOR);
+
+						// walls to the east or south of a visible tile, we see that too
+						Tile* t = _save->getTile(Position(posVisited.x + 1, posVisited.y, posVisited.z));
+						if (t)
+							t->setDiscovered(true, O_WESTWALL);
+						t = _save->getTile(Position(posVisited.x, posVisited.y + 1, posVisited.z));
+						if (t)
+							t->setDiscovered(true, O_NORTHWALL);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Makes sure shared fan of lines used by tile FOV cover view range of unit of given size.
+ * Fan is rebuilt only when range grows, so after this call it is only read
+ * and `visibleTilesFrom` can be used from many threads at once, each with its own marks.
+ * @param unitSize Size of unit, eyes of big units are offset from its position.
+ */
+void TileEngine::reserveTilesInFOV(int unitSize)
+{
+	_rayFan.reserve(getMaxViewDistance() + 2 * (unitSize - 1), _save->getMapSizeZ());
+}
+
+/**
+ * Finds all tiles seen from eye by tile lines to given targets.
+ * Gives same tiles as tracing `calculateLineTile` to each target separately
+ * and keeping every tile before impact, but common beginnings of lines are checked only once.
+ * Fan need already cover range of unit, see `reserveTilesInFOV`.
+ * @param eye Origin of lines.
+ * @param targets Tiles to trace lines to, need be inside map and inside view range of unit position.
+ * @param visible Found tiles, some can be repeated.
+ * @param marks Scratch buffer of lines requested by this query, only one thread can use it at once.
+ */
+void TileEngine::traceTilesInFOV(Position eye, const std::vector<Position>& targets, std::vector<Tile*>& visible, TileRayFan::Marks& marks)
+{
+	_rayFan.clearMarks(marks);
+	for (const auto& target : targets)
+	{
+		_rayFan.markTarget(marks, target - eye);
+	}
+	_rayFan.trace(marks,
+		[&](const TileRayFan::Node& node, bool isTarget)
+		{
+			const Position pos = eye + node.offset;
+			const auto& cache = _blockVisibility[_save->getTileIndex(pos - node.step)];
+
+			auto result = getBlockDir(cache, node.dir, node.step.z);
+			if (result)
+			{
+				// big wall stop lines that pass it, but not the one that ends on it
+				if (isTarget && node.step.z == 0 && getBigWallDir(cache, node.dir))
+				{
+					visible.push_back(_save->getTile(pos));
+				}
+				return false;
+			}
+			visible.push_back(_save->getTile(pos));
+			return true;
+		}
+	);
 }
 
 /**
@@ -1646,6 +1658,8 @@ void TileEngine::calculateTilesInFOV(BattleUnit* unit, const Position eventPos,
 */
 bool TileEngine::calculateFOV(BattleUnit *unit, bool doTileRecalc, bool doUnitRecalc)
 {
+	PhaseTimer::Scope phaseScope(TP_FOV);
+	++_viewRevision;
 	//Force a full FOV recheck for this unit.
 	if (doTileRecalc) calculateTilesInFOV(unit);
 	return doUnitRecalc ? calculateUnitsInFOV(unit) : false;
@@ -1867,6 +1881,7 @@ std::tuple<int, int, int, int, int> getTrajectoryDataHelper(TileEngine* te, cons
  */
 bool TileEngine::visible(BattleUnit *currentUnit, Tile *tile)
 {
+	PhaseTimer::Scope phaseScope(TP_EXPOSURE);
 	// if there is no tile or no unit, we can't see it
 	if (!tile || !tile->getUnit())
 	{
@@ -2123,8 +2138,127 @@ bool TileEngine::isTileInLOS(BattleAction *action, Tile *tile, bool drawing)
 	return seen;
 }
 
+/**
+ * Traces several lines from one origin, stepping all of them together.
+ * Lines use same bresenham algorithm as `calculateLineVoxel`, but state of each line is kept in flat arrays
+ * and no trajectory is stored, only the voxel where line stopped.
+ * @param origin Origin in voxel space, common for all lines.
+ * @param targets Array of target voxels.
+ * @param count Number of lines, at most `MaxBatchRays`.
+ * @param excludeUnit Excludes this unit in the collision detection.
+ * @param results Array that get voxel type that each line hit.
+ * @param impacts Array that get position of impact of each line, valid only when result is not V_EMPTY.
+ */
+void TileEngine::traceVoxelRays(Position origin, const Position *targets, int count, BattleUnit *excludeUnit, VoxelType *results, Position *impacts)
+{
+	assert(count <= MaxBatchRays);
+
+	const bool excludeAllUnits = _save->isBeforeGame();
+
+	int x[MaxBatchRays], y[MaxBatchRays], z[MaxBatchRays], endX[MaxBatchRays];
+	int deltaX[MaxBatchRays], deltaY[MaxBatchRays], deltaZ[MaxBatchRays];
+	int stepX[MaxBatchRays], stepY[MaxBatchRays], stepZ[MaxBatchRays];
+	int driftXY[MaxBatchRays], driftXZ[MaxBatchRays];
+	bool swapXY[MaxBatchRays], swapXZ[MaxBatchRays];
+	int active[MaxBatchRays];
+	int activeCount = 0;
+
+	for (int i = 0; i < count; ++i)
+	{
+		int x0 = origin.x, x1 = targets[i].x;
+		int y0 = origin.y, y1 = targets[i].y;
+		int z0 = origin.z, z1 = targets[i].z;
+
+		swapXY[i] = std::abs(y1 - y0) > std::abs(x1 - x0);
+		if (swapXY[i])
+		{
+			std::swap(x0, y0);
+			std::swap(x1, y1);
+		}
+		swapXZ[i] = std::abs(z1 - z0) > std::abs(x1 - x0);
+		if (swapXZ[i])
+		{
+			std::swap(x0, z0);
+			std::swap(x1, z1);
+		}
+
+		deltaX[i] = std::abs(x1 - x0);
+		deltaY[i] = std::abs(y1 - y0);
+		deltaZ[i] = std::abs(z1 - z0);
+		driftXY[i] = deltaX[i] / 2;
+		driftXZ[i] = deltaX[i] / 2;
+		stepX[i] = x0 > x1 ? -1 : 1;
+		stepY[i] = y0 > y1 ? -1 : 1;
+		stepZ[i] = z0 > z1 ? -1 : 1;
+		x[i] = x0;
+		y[i] = y0;
+		z[i] = z0;
+		endX[i] = x1;
+
+		results[i] = V_EMPTY;
+		active[activeCount++] = i;
+	}
+
+	auto check = [&](int i)
+	{
+		int cx = x[i], cy = y[i], cz = z[i];
+		if (swapXZ[i]) std::swap(cx, cz);
+		if (swapXY[i]) std::swap(cx, cy);
+		const Position point = Position(cx, cy, cz);
+		const VoxelType result = voxelCheck(point, excludeUnit, excludeAllUnits);
+		if (result != V_EMPTY)
+		{
+			results[i] = result;
+			impacts[i] = point;
+			return true;
+		}
+		return false;
+	};
+
+	while (activeCount > 0)
+	{
+		int stillActive = 0;
+		for (int a = 0; a < activeCount; ++a)
+		{
+			const int i = active[a];
+
+			if (check(i) || x[i] == endX[i])
+			{
+				continue;
+			}
+
+			driftXY[i] -= deltaY[i];
+			driftXZ[i] -= deltaZ[i];
+
+			if (driftXY[i] < 0)
+			{
+				y[i] += stepY[i];
+				driftXY[i] += deltaX[i];
+				if (check(i))
+				{
+					continue;
+				}
+			}
+			if (driftXZ[i] < 0)
+			{
+				z[i] += stepZ[i];
+				driftXZ[i] += deltaX[i];
+				if (check(i))
+				{
+					continue;
+				}
+			}
+
+			x[i] += stepX[i];
+			active[stillActive++] = i;
+		}
+		activeCount = stillActive;
+	}
+}
+
 /**
  * Checks for how exposed unit is for another unit.
+ * When no voxels or debug output are requested, result is memorized until something changes between origin and target.
  * @param originVoxel Voxel of trace origin (eye or gun's barrel).
  * @param tile The tile to check for.
  * @param excludeUnit Is self (not to hit self).
@@ -2134,10 +2268,48 @@ bool TileEngine::isTileInLOS(BattleAction *action, Tile *tile, bool drawing)
 double TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleUnit *excludeUnit, bool isDebug,
                                     std::vector<Position> *exposedVoxels, std::vector<Position> *coveredVoxels, bool isSimpleMode)
 {
+	PhaseTimer::Scope phaseScope(TP_EXPOSURE);
 	isDebug = isDebug && _save->getDebugMode();
 	if (excludeUnit && excludeUnit->isAIControlled()) isSimpleMode = true;
 
-	std::vector<Position> _trajectory;
+	BattleUnit *targetUnit = tile->getUnit();
+	if (isDebug || exposedVoxels || coveredVoxels || targetUnit == nullptr || targetUnit == excludeUnit)
+	{
+		return scanVoxelExposure(originVoxel, tile, excludeUnit, isDebug, exposedVoxels, coveredVoxels, isSimpleMode);
+	}
+
+	const int targetSize = targetUnit->getArmor()->getSize();
+	const Position targetCorner = tile->getPosition() + Position(targetSize - 1, targetSize - 1, 0);
+	VisibilityMemoKey key;
+	key.origin = *originVoxel;
+	key.target = tile->getPosition();
+	key.unitA = excludeUnit ? excludeUnit->getId() : -1;
+	key.unitB = targetUnit->getId();
+	key.flags = isSimpleMode | (targetUnit->isOut() << 1) | (targetUnit->getHeight() << 2) | (targetUnit->getFloatHeight() << 10);
+	key.type = VMT_EXPOSURE;
+
+	float memoValue = 0.0f;
+	if (_visibilityMemo.find(key, originVoxel->toTile(), targetCorner, memoValue))
+	{
+		return memoValue;
+	}
+	const double exposure = scanVoxelExposure(originVoxel, tile, excludeUnit, isDebug, exposedVoxels, coveredVoxels, isSimpleMode);
+	_visibilityMemo.store(key, originVoxel->toTile(), targetCorner, (float)exposure);
+	return exposure;
+}
+
+/**
+ * Scans target cylinder to check how exposed unit is for another unit.
+ * Debug and simple mode flags are expected to be already resolved by checkVoxelExposure.
+ * @param originVoxel Voxel of trace origin (eye or gun's barrel).
+ * @param tile The tile to check for.
+ * @param excludeUnit Is self (not to hit self).
+ * @param exposedVoxels [Optional] Array of positions of exposed voxels (function fills it)
+ * @return Degree of exposure (as percent).
+ */
+double TileEngine::scanVoxelExposure(Position *originVoxel, Tile *tile, BattleUnit *excludeUnit, bool isDebug,
+                                    std::vector<Position> *exposedVoxels, std::vector<Position> *coveredVoxels, bool isSimpleMode)
+{
 	Position scanVoxel;
 	BattleUnit *targetUnit = tile->getUnit();
 	if (targetUnit == nullptr) return 0; //no unit in this tile, even if it elevated and appearing in it.
@@ -2188,8 +2360,8 @@ double TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleU
 	int relY = sliceTargetsY[0];
 	int sliceTargetsTopBottom[] = { relY, -relX, -relY, relX }; // front/back scan points
 
+	// ASCII picture of scan is only build for debug output
 	std::vector<std::string> scanArray;
-	scanArray.reserve(24);
 	const char symbols[] = {'.','_','/','\\','o','u','x'};
 
 	// scan rays from top to bottom, every voxel of target cylinder
@@ -2210,9 +2382,61 @@ double TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleU
 	if (targetSize == 2) simplifyDivider = 4;
     int peekDistanceSq = _save->getMod()->getAccuracyModConfig()->peekDistance * _save->getMod()->getAccuracyModConfig()->peekDistance;
 
+	auto isTargetImpact = [&](Position impact)
+	{
+		return impact.x >= unitMin_X && impact.x <= unitMax_X &&
+			impact.y >= unitMin_Y && impact.y <= unitMax_Y &&
+			impact.z >= targetMinHeight+1 && impact.z <= targetMaxHeight;
+	};
+
+	// all rays of target cylinder are traced together in batches
+	Position batchTargets[MaxBatchRays];
+	VoxelType batchResults[MaxBatchRays];
+	Position batchImpacts[MaxBatchRays];
+	int batchLine[MaxBatchRays];
+	int batchColumn[MaxBatchRays];
+	int batchSize = 0;
+
+	auto flushBatch = [&]()
+	{
+		traceVoxelRays(*originVoxel, batchTargets, batchSize, excludeUnit, batchResults, batchImpacts);
+		for (int i = 0; i < batchSize; ++i)
+		{
+			const VoxelType test = batchResults[i];
+			const Position& impact = batchImpacts[i];
+			const bool peekBehindCover = test != V_EMPTY && Position::distanceSq(*originVoxel, impact) <= peekDistanceSq;
+			char symbol = symbols[ test+1 ]; // V_EMPTY = -1
+
+			if (test == V_UNIT && isTargetImpact(impact))
+			{
+				++visible;
+				if (exposedVoxels) exposedVoxels->emplace_back(batchTargets[i]);
+				symbol = '#';
+			}
+			else if (test == V_EMPTY || peekBehindCover)
+			{
+				--total;
+			}
+			else if (coveredVoxels)
+			{
+				coveredVoxels->emplace_back(impact); // Target can't be covered by void, overlapped by another unit is cover
+			}
+
+			if (isDebug)
+			{
+				scanArray[batchLine[i]][batchColumn[i]] = symbol;
+			}
+		}
+		batchSize = 0;
+	};
+
 	for (int height = targetMaxHeight; height >= bottomHeight; height -= 2)
 	{
-		std::string scanLine;
+		const int line = (int)scanArray.size();
+		if (isDebug)
+		{
+			scanArray.emplace_back(std::string(unitRadius*2 + 1, '.') + " " + std::to_string( height % Position::TileZ ));
+		}
 		scanVoxel.z = height;
 
 		for (int j = 0; j <= unitRadius*2; ++j)
@@ -2220,7 +2444,6 @@ double TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleU
 			// Skip voxels in "simple" mode. usually to speed up AI calculations
 			if (isSimpleMode && (height + j) % simplifyDivider != 0)
 			{
-				scanLine += '.';
 				continue; // scan every N-th voxel
 			}
 
@@ -2228,51 +2451,22 @@ double TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleU
 			scanVoxel.x = targetVoxel.x + sliceTargetsX[j];
 			scanVoxel.y = targetVoxel.y + sliceTargetsY[j];
 
-			_trajectory.clear();
-			int test = calculateLineVoxel(*originVoxel, scanVoxel, false, &_trajectory, excludeUnit);
-
-            bool peekBehindCover = false;
-            if (!_trajectory.empty())
-            {
-                peekBehindCover = (Position::distanceSq(*originVoxel, _trajectory.at(0)) <= peekDistanceSq);
-            }
-
-            if (test == V_UNIT)
+			batchTargets[batchSize] = scanVoxel;
+			batchLine[batchSize] = line;
+			batchColumn[batchSize] = j;
+			if (++batchSize == MaxBatchRays)
 			{
-				int impactX = _trajectory.at(0).x;
-				int impactY = _trajectory.at(0).y;
-				int impactZ = _trajectory.at(0).z;
-
-				if (impactX >= unitMin_X && impactX <= unitMax_X &&
-					impactY >= unitMin_Y && impactY <= unitMax_Y &&
-					impactZ >= targetMinHeight+1 && impactZ <= targetMaxHeight)
-				{
-					++visible;
-					if (exposedVoxels) exposedVoxels->emplace_back(scanVoxel);
-					scanLine += '#';
-				}
-				else
-                {
-                    if (peekBehindCover) --total;
-                    else if (coveredVoxels) coveredVoxels->emplace_back(_trajectory.at(0));
-                    scanLine += symbols[ test+1 ]; // overlapped by another unit
-                }
-			}
-
-			else
-			{
-				if ( test == V_EMPTY || peekBehindCover ) --total;
-                else if (coveredVoxels) coveredVoxels->emplace_back(_trajectory.at(0)); // Target can't be covered by void
-
-				scanLine += symbols[ test+1 ]; // V_EMPTY = -1
+				flushBatch();
 			}
 		}
-		scanLine += " " + std::to_string( height % Position::TileZ );
-		scanArray.emplace_back( scanLine );
 
 		// Additional bottom layer for units with odd height
 		if (targetFloatHeight > 1 && heightRange % 2 == 0 && height - bottomHeight == 1) ++height;
 	}
+	if (batchSize > 0)
+	{
+		flushBatch();
+	}
 	double exposure = (double)visible / total;
 
 	if (isDebug)
@@ -2298,43 +2492,28 @@ double TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleU
 
 		for ( int i = 0; i < 2; ++i)
 		{
-			scanVoxel.z = heights[ i ];
-			scanVoxel.x = targetVoxel.x + sliceTargetsTopBottom[ i * 2 ];
-			scanVoxel.y = targetVoxel.y + sliceTargetsTopBottom[ i * 2 + 1];
-
-			_trajectory.clear();
-			int test = calculateLineVoxel(*originVoxel, scanVoxel, false, &_trajectory, excludeUnit);
+			batchTargets[i].z = heights[ i ];
+			batchTargets[i].x = targetVoxel.x + sliceTargetsTopBottom[ i * 2 ];
+			batchTargets[i].y = targetVoxel.y + sliceTargetsTopBottom[ i * 2 + 1];
+		}
+		traceVoxelRays(*originVoxel, batchTargets, 2, excludeUnit, batchResults, batchImpacts);
 
-            bool peekBehindCover = false;
-            if (!_trajectory.empty())
-            {
-                peekBehindCover = (Position::distanceSq(*originVoxel, _trajectory.at(0)) <= peekDistanceSq);
-            }
+		for ( int i = 0; i < 2; ++i)
+		{
+			const VoxelType test = batchResults[i];
+			const Position& impact = batchImpacts[i];
+			const bool peekBehindCover = test != V_EMPTY && Position::distanceSq(*originVoxel, impact) <= peekDistanceSq;
 
-			if (test == V_UNIT)
+			if (test == V_UNIT && isTargetImpact(impact))
 			{
-				int impactX = _trajectory.at(0).x;
-				int impactY = _trajectory.at(0).y;
-				int impactZ = _trajectory.at(0).z;
-
-				if (impactX >= unitMin_X && impactX <= unitMax_X &&
-					impactY >= unitMin_Y && impactY <= unitMax_Y &&
-					impactZ >= targetMinHeight+1 && impactZ <= targetMaxHeight)
-				{
-					exposure += 0.05;
-					if (exposedVoxels) exposedVoxels->emplace_back(scanVoxel);
-				}
-                else
-                {
-                    if (peekBehindCover) --total;
-                    else if (coveredVoxels) coveredVoxels->emplace_back(_trajectory.at(0));
-                }
+				exposure += 0.05;
+				if (exposedVoxels) exposedVoxels->emplace_back(batchTargets[i]);
+			}
+			else if (test != V_EMPTY)
+			{
+				if ( peekBehindCover ) --total;
+				else if (coveredVoxels) coveredVoxels->emplace_back(impact); // Target can't be covered by void
 			}
-            else if (test != V_EMPTY)
-            {
-                if ( peekBehindCover ) --total;
-                else if (coveredVoxels) coveredVoxels->emplace_back(_trajectory.at(0)); // Target can't be covered by void
-            }
 		}
 	}
 
@@ -2353,6 +2532,7 @@ double TileEngine::checkVoxelExposure(Position *originVoxel, Tile *tile, BattleU
  */
 bool TileEngine::canTargetUnit(Position *originVoxel, Tile *tile, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles, BattleUnit *potentialUnit)
 {
+	PhaseTimer::Scope phaseScope(TP_EXPOSURE);
 	std::vector<Position> _trajectory;
 
 	BattleUnit *targetUnit;
@@ -2599,6 +2779,7 @@ bool TileEngine::canTargetUnit(Position *originVoxel, Tile *tile, Position *scan
  */
 bool TileEngine::canTargetTile(Position *originVoxel, Tile *tile, int part, Position *scanVoxel, BattleUnit *excludeUnit, bool rememberObstacles)
 {
+	PhaseTimer::Scope phaseScope(TP_EXPOSURE);
 	static int sliceObjectSpiral[82] = {8,8, 8,6, 10,6, 10,8, 10,10, 8,10, 6,10, 6,8, 6,6, //first circle
 		8,4, 10,4, 12,4, 12,6, 12,8, 12,10, 12,12, 10,12, 8,12, 6,12, 4,12, 4,10, 4,8, 4,6, 4,4, 6,4, //second circle
 		8,1, 12,1, 15,1, 15,4, 15,8, 15,12, 15,15, 12,15, 8,15, 4,15, 1,15, 1,12, 1,8, 1,4, 1,1, 4,1}; //third circle
@@ -2815,19 +2996,29 @@ Position TileEngine::adjustTargetVoxelFromTileType(Position *originVoxel, Tile *
  */
 void TileEngine::calculateFOV(Position position, int eventRadius, const bool updateTiles, const bool appendToTileVisibility)
 {
+	PhaseTimer::Scope phaseScope(TP_FOV);
+	++_viewRevision;
+	int updateDistance;
 	int updateRadius;
 	if (eventRadius == -1)
 	{
 		eventRadius = getMaxViewDistance();
+		updateDistance = getMaxViewDistance();
 		updateRadius = getMaxViewDistanceSq();
 	}
 	else
 	{
 		//Need to grab units which are out of range of the centre of the event, but can still see the edge of the effect.
-		updateRadius = getMaxViewDistance() + (eventRadius > 0 ? eventRadius : 0);
-		updateRadius *= updateRadius;
+		updateDistance = getMaxViewDistance() + (eventRadius > 0 ? eventRadius : 0);
+		updateRadius = updateDistance * updateDistance;
 	}
-	for (auto* bu : *_save->getUnits())
+
+	// only units in nearby cells could observe the event
+	std::vector<BattleUnit*> observers;
+	_unitGrid.sync(*_save->getUnits());
+	_unitGrid.find(position, updateDistance, observers);
+	_reactionFovPosition = position;
+	for (auto* bu : observers)
 	{
 		if (Position::distance2dSq(position, bu->getPosition()) <= updateRadius) //could this unit have observed the event?
 		{
@@ -2853,6 +3044,7 @@ void TileEngine::calculateFOV(Position position, int eventRadius, const bool upd
  */
 bool TileEngine::checkReactionFire(BattleUnit *unit, const BattleAction &originalAction)
 {
+	PhaseTimer::Scope phaseScope(TP_REACTION);
 	if (_save->isPreview())
 	{
 		return false;
@@ -2864,7 +3056,11 @@ bool TileEngine::checkReactionFire(BattleUnit *unit, const BattleAction &origina
 		return false;
 	}
 
-	std::vector<ReactionScore> spotters = getSpottingUnits(unit);
+	// visibility of unit is known only when FOV was updated for its current position just before this check
+	const bool fovKnown = _reactionFovPosition == unit->getPosition();
+	_reactionFovPosition = invalid;
+
+	std::vector<ReactionScore> spotters = getSpottingUnits(unit, fovKnown);
 	bool result = false;
 
 	// not mind controlled, or controlled by the player
@@ -2904,10 +3100,12 @@ bool TileEngine::checkReactionFire(BattleUnit *unit, const BattleAction &origina
 
 /**
  * Creates a vector of units that can spot this unit.
+ * Only units in cells of unit grid near the unit are considered.
  * @param unit The unit to check for spotters of.
+ * @param fovKnown Visible units of all spotters are up to date for current position of unit.
  * @return A vector of units that can see this unit.
  */
-std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit* unit)
+std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit* unit, bool fovKnown)
 {
 	std::vector<TileEngine::ReactionScore> spotters;
 	Tile *tile = unit->getTile();
@@ -2915,7 +3113,11 @@ std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit*
 	// no reaction on civilian turn.
 	if (_save->getSide() != FACTION_NEUTRAL)
 	{
-		for (auto* bu : *_save->getUnits())
+		// units come in order in which they are stored in battle, first of equal reactors wins
+		std::vector<BattleUnit*> candidates;
+		_unitGrid.sync(*_save->getUnits());
+		_unitGrid.find(unit->getPosition(), getMaxViewDistance(), candidates);
+		for (auto* bu : candidates)
 		{
 				// not dead/unconscious
 			if (!bu->isOut() &&
@@ -2961,12 +3163,21 @@ std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit*
 					gotHit = bu->wasMeleeAttackedBy(unit->getId());
 				}
 
+				// FOV pass already checked view sector and sight of the same unit, there is no need to trace it again,
+				// turret direction and big units are not checked there the same way.
+				const bool sightKnown = fovKnown && !gotHit && !(Options::strafe && bu->getTurretType() > -1);
+				if (sightKnown && !bu->hasVisibleUnit(unit))
+				{
+					continue;
+				}
+				const bool unitSeen = sightKnown && unit->getArmor()->getSize() == 1;
+
 					// can actually see the target Tile, or we got hit
-				if ((bu->checkViewSector(unit->getPosition()) || gotHit) &&
+				if ((unitSeen || bu->checkViewSector(unit->getPosition()) || gotHit) &&
 					// can actually target the unit
 					canTargetUnit(&originVoxel, tile, &targetVoxel, bu, false) &&
 					// can actually see the unit
-					visible(bu, tile))
+					(unitSeen || visible(bu, tile)))
 				{
 					if (bu->getFaction() == FACTION_PLAYER)
 					{
@@ -3067,18 +3278,18 @@ std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit*
 								{
 									// Apply the exposure
 									double coverEfficiencyCoeff = AccuracyMod->coverEfficiency[(int)Options::battleRealisticCoverEfficiency] / 100.0;
-									accuracyFloat = accuracyFloat * coverEfficiencyCoeff * maxExposure + accuracyFloat * (1.0 - coverEfficiencyCoeff);
+									accuracyFloat = HitChanceTable::applyExposure(accuracyFloat, maxExposure, coverEfficiencyCoeff);
 								}
 
 								accuracy = round(accuracyFloat);
 								distance = round(distanceFloat);
 								if (distance < 1) distance = 1;
 
-								accuracy = Projectile::getHitChance(distance, accuracy, _save->getMod()->getHitChancesTable(targetSize));
+								accuracy = _save->getMod()->getHitChance(targetSize, distance, accuracy);
 							}
                             else if (Options::useChanceToHit)
 							{
-								accuracy = Projectile::getHitChance(distance, accuracy, _save->getMod()->getHitChancesTable( targetSize ));
+								accuracy = _save->getMod()->getHitChance(targetSize, distance, accuracy);
 							}
 
 							if (accuracy >= reactionFireThreshold && !outOfRange)
@@ -3744,7 +3955,6 @@ void TileEngine::hit(BattleActionAttack attack, Position center, int power, cons
 	//Recalculate relevant item/unit locations and visibility depending on what happened during the hit
 	if (terrainChanged || effectGenerated)
 	{
-		resetVisibilityCache();
 		applyGravity(tile);
 		auto layer = LL_ITEMS;
 		if (part == V_FLOOR && _save->getTile(tilePos - Position(0, 0, 1)))
@@ -3785,10 +3995,7 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	const Position centetTile = center.toTile();
 	int hitSide = 0;
 	int diagonalWall = 0;
-	int power_;
-	std::map<Tile*, int> tilesAffected;
 	std::vector<BattleItem*> toRemove;
-	std::pair<std::map<Tile*, int>::iterator, bool> ret;
 
 	if (type->FireBlastCalc)
 	{
@@ -3811,168 +4018,203 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	}
 
 	Tile *origin = _save->getTile(Position(centetTile));
-	Tile *dest = nullptr;
+	Uint8 skipMask = 0;
 	if (origin->isBigWall()) //pre-calculations for bigwall deflection
 	{
 		diagonalWall = origin->getMapData(O_OBJECT)->getBigWall();
 		if (diagonalWall == Pathfinding::BIGWALLNWSE) //  3 |
+		{
 			hitSide = (center.x % 16 - center.y % 16) > 0 ? 1 : -1;
+			skipMask = hitSide > 0 ? ExplosionRayFan::SkipNWSEPositive : ExplosionRayFan::SkipNWSENegative;
+		}
 		if (diagonalWall == Pathfinding::BIGWALLNESW) //  2 --
+		{
 			hitSide = (center.x % 16 + center.y % 16 - 15) > 0 ? 1 : -1;
+			skipMask = hitSide > 0 ? ExplosionRayFan::SkipNESWPositive : ExplosionRayFan::SkipNESWNegative;
+		}
 	}
 
-	for (int fi = -90; fi <= 90; fi += 5)
+	// every ray lose at least `RadiusReduction` per step and can't leave map, no need to build it any longer.
+	int maxDepth = maxRadius;
+	maxDepth = std::min(maxDepth, (int)std::ceil(std::sqrt((double)_save->getMapSizeX() * _save->getMapSizeX() + _save->getMapSizeY() * _save->getMapSizeY() + _save->getMapSizeZ() * _save->getMapSizeZ())) + 1);
+	if (type->RadiusReduction > 0)
 	{
-		// raytrace every 3 degrees makes sure we cover all tiles in a circle.
-		for (int te = 0; te <= 360; te += 3)
+		// computed in floating point, reduction can be fractional and a tiny one would overflow `int`
+		const double reductionDepth = std::ceil(power / (double)type->RadiusReduction) + 1;
+		if (reductionDepth < maxDepth)
 		{
-			double cos_te = cos(Deg2Rad(te));
-			double sin_te = sin(Deg2Rad(te));
-			double sin_fi = sin(Deg2Rad(fi));
-			double cos_fi = cos(Deg2Rad(fi));
+			maxDepth = (int)reductionDepth;
+		}
+	}
+	_explosionFan.reserve(std::max(maxDepth, 0));
 
-			origin = _save->getTile(centetTile);
-			dest = origin;
-			double l = 0;
-			int tileX, tileY, tileZ;
-			power_ = power;
-			while (power_ > 0 && l <= maxRadius)
-			{
-				if (power_ > 0)
-				{
-					ret = tilesAffected.insert(std::make_pair(dest, 0)); // check if we had this tile already affected
+	if (_explosionTiles.size() != (size_t)_save->getMapSizeXYZ())
+	{
+		_explosionTiles.assign(_save->getMapSizeXYZ(), ExplosionTile{ ExplosionTile::NotVisited, 0, 0 });
+	}
+	_explosionNodes.resize(_explosionFan.getNodesCount());
 
-					const int tileDmg = type->getTileFinalDamage(power_);
-					if (tileDmg > ret.first->second)
-					{
-						ret.first->second = tileDmg;
-					}
-					if (ret.second)
-					{
-						const int damage = type->getRandomDamage(power_);
-						BattleUnit *bu = dest->getOverlappingUnit(_save);
+	// first pass: follow all rays together and find how much power reach each tile, terrain is not changed here.
+	_explosionFan.trace(
+		[&](const ExplosionRayFan::Node& node, int index)
+		{
+			Tile *dest = nullptr;
+			int power_ = power;
+			if (node.parent < 0)
+			{
+				dest = origin;
+			}
+			else
+			{
+				const ExplosionNode& prev = _explosionNodes[node.parent];
+				Tile *from = prev.tile;
+				dest = _save->getTile(centetTile + node.offset);
 
-						toRemove.clear();
-						if (bu)
-						{
-							if (dest->getPosition() == centetTile)
-							{
-								// direct hit, similar to ground zero but AI will remember attacker, done for compatibility
-								hitUnit(attack, bu, Position(0, 0, 0), damage, type, rangeAtack);
-							}
-							else if (
-									(
-										Position::distance2dSq(dest->getPosition(), centetTile) < 4
-										&& dest->getPosition().z == centetTile.z
-									)
-									|| dest->getPosition().z > centetTile.z
-								)
-							{
-								// ground zero effect is in effect, or unit is above explosion
-								hitUnit(attack, bu, Position(0, 0, -1), damage, type, rangeAtack);
-							}
-							else
-							{
-								// directional damage relative to explosion position.
-								// units above the explosion will be hit in the legs, units lateral to or below will be hit in the torso
-								hitUnit(attack, bu, centetTile + Position(0, 0, 5) - dest->getPosition(), damage, type, rangeAtack);
-							}
+				if (!dest) return false; // out of map!
 
-							// Affect all items and units in inventory
-							const int itemDamage = bu->getOverKillDamage();
-							if (itemDamage > 0)
-							{
-								for (auto* bi : *bu->getInventory())
-								{
-									if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), itemDamage, type, rangeAtack) && type->getItemFinalDamage(itemDamage) > bi->getRules()->getArmor())
-									{
-										toRemove.push_back(bi);
-									}
-								}
-							}
-						}
-						// Affect all items and units on ground
-						for (auto* bi : *dest->getInventory())
-						{
-							if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), damage, type) && type->getItemFinalDamage(damage) > bi->getRules()->getArmor())
-							{
-								toRemove.push_back(bi);
-							}
-						}
-						for (auto* bi : toRemove)
-						{
-							_save->removeItem(bi);
-						}
+				power_ = prev.power;
+				// blockage by terrain is deducted from the explosion power
+				power_ -= type->RadiusReduction; // explosive damage decreases by 10 per tile
+				if (node.step.z != 0)
+					power_ -= vertdec; //3d explosion factor
 
-						hitTile(dest, damage, type);
-					}
+				if (type->FireBlastCalc)
+				{
+					if (node.dir != -1 && node.dir % 2) power_ -= 0.5f * type->RadiusReduction; // diagonal movement costs an extra 50% for fire.
 				}
+				if (node.depth > 1)
+				{
+					power_ -= verticalBlockage(from, dest, type->ResistType, false) * 2;
+					power_ -= horizontalBlockage(from, dest, type->ResistType, false) * 2;
+				}
+				else //tricky bigwall deflection /Volutar
+				{
+					bool skipObject = diagonalWall == 0 || (node.skip & skipMask);
+					power_ -= verticalBlockage(from, dest, type->ResistType, skipObject) * 2;
+					power_ -= horizontalBlockage(from, dest, type->ResistType, skipObject) * 2;
+				}
+			}
+			if (power_ <= 0 || node.depth > maxRadius)
+			{
+				return false;
+			}
+			_explosionNodes[index] = ExplosionNode{ dest, power_ };
 
-				l += 1.0;
-
-				tileX = int(floor(centetTile.x + 0.5 + l * sin_te * cos_fi));
-				tileY = int(floor(centetTile.y + 0.5 + l * cos_te * cos_fi));
-				tileZ = int(floor(centetTile.z + 0.5 + l * sin_fi));
+			// rays are cast one by one, so tile is first affected by earliest ray that reach it.
+			const int tileIndex = _save->getTileIndex(dest->getPosition());
+			ExplosionTile& affected = _explosionTiles[tileIndex];
+			const Uint32 visit = ((Uint32)node.ray << 16) | (Uint32)node.depth;
+			if (affected.firstVisit == ExplosionTile::NotVisited)
+			{
+				_explosionTouched.push_back(tileIndex);
+			}
+			if (visit < affected.firstVisit)
+			{
+				affected.firstVisit = visit;
+				affected.firstPower = power_;
+			}
+			const int tileDmg = type->getTileFinalDamage(power_);
+			if (tileDmg > affected.tileDamage)
+			{
+				affected.tileDamage = tileDmg;
+			}
+			return true;
+		}
+	);
 
-				origin = dest;
-				dest = _save->getTile(Position(tileX, tileY, tileZ));
+	struct AffectedTile
+	{
+		Uint32 firstVisit;
+		int tileIndex;
+		int power;
+		int tileDamage;
+	};
+	std::vector<AffectedTile> tilesAffected;
+	tilesAffected.reserve(_explosionTouched.size());
+	for (int tileIndex : _explosionTouched)
+	{
+		ExplosionTile& affected = _explosionTiles[tileIndex];
+		tilesAffected.push_back(AffectedTile{ affected.firstVisit, tileIndex, affected.firstPower, affected.tileDamage });
+		affected = ExplosionTile{ ExplosionTile::NotVisited, 0, 0 };
+	}
+	_explosionTouched.clear();
 
-				if (!dest) break; // out of map!
+	// second pass: hit units, items and tiles in same order as rays would reach them one by one.
+	std::sort(tilesAffected.begin(), tilesAffected.end(), [](const AffectedTile& a, const AffectedTile& b) { return a.firstVisit < b.firstVisit; });
+	for (const auto& affected : tilesAffected)
+	{
+		Tile *dest = _save->getTile(affected.tileIndex);
+		const int damage = type->getRandomDamage(affected.power);
+		BattleUnit *bu = dest->getOverlappingUnit(_save);
 
-				// blockage by terrain is deducted from the explosion power
-				power_ -= type->RadiusReduction; // explosive damage decreases by 10 per tile
-				if (origin->getPosition().z != tileZ)
-					power_ -= vertdec; //3d explosion factor
+		toRemove.clear();
+		if (bu)
+		{
+			if (dest->getPosition() == centetTile)
+			{
+				// direct hit, similar to ground zero but AI will remember attacker, done for compatibility
+				hitUnit(attack, bu, Position(0, 0, 0), damage, type, rangeAtack);
+			}
+			else if (
+					(
+						Position::distance2dSq(dest->getPosition(), centetTile) < 4
+						&& dest->getPosition().z == centetTile.z
+					)
+					|| dest->getPosition().z > centetTile.z
+				)
+			{
+				// ground zero effect is in effect, or unit is above explosion
+				hitUnit(attack, bu, Position(0, 0, -1), damage, type, rangeAtack);
+			}
+			else
+			{
+				// directional damage relative to explosion position.
+				// units above the explosion will be hit in the legs, units lateral to or below will be hit in the torso
+				hitUnit(attack, bu, centetTile + Position(0, 0, 5) - dest->getPosition(), damage, type, rangeAtack);
+			}
 
-				if (type->FireBlastCalc)
+			// Affect all items and units in inventory
+			const int itemDamage = bu->getOverKillDamage();
+			if (itemDamage > 0)
+			{
+				for (auto* bi : *bu->getInventory())
 				{
-					int dir;
-					Pathfinding::vectorToDirection(origin->getPosition() - dest->getPosition(), dir);
-					if (dir != -1 && dir %2) power_ -= 0.5f * type->RadiusReduction; // diagonal movement costs an extra 50% for fire.
-				}
-				if (l > 0.5) {
-					if ( l > 1.5)
-					{
-						power_ -= verticalBlockage(origin, dest, type->ResistType, false) * 2;
-						power_ -= horizontalBlockage(origin, dest, type->ResistType, false) * 2;
-					}
-					else //tricky bigwall deflection /Volutar
+					if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), itemDamage, type, rangeAtack) && type->getItemFinalDamage(itemDamage) > bi->getRules()->getArmor())
 					{
-						bool skipObject = diagonalWall == 0;
-						if (diagonalWall == Pathfinding::BIGWALLNESW) // --
-						{
-							if (hitSide<0 && te >= 135 && te < 315)
-								skipObject = true;
-							if (hitSide>0 && ( te < 135 || te > 315))
-								skipObject = true;
-						}
-						if (diagonalWall == Pathfinding::BIGWALLNWSE) // |
-						{
-							if (hitSide>0 && te >= 45 && te < 225)
-								skipObject = true;
-							if (hitSide<0 && ( te < 45 || te > 225))
-								skipObject = true;
-						}
-						power_ -= verticalBlockage(origin, dest, type->ResistType, skipObject) * 2;
-						power_ -= horizontalBlockage(origin, dest, type->ResistType, skipObject) * 2;
-
+						toRemove.push_back(bi);
 					}
 				}
 			}
 		}
+		// Affect all items and units on ground
+		for (auto* bi : *dest->getInventory())
+		{
+			if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), damage, type) && type->getItemFinalDamage(damage) > bi->getRules()->getArmor())
+			{
+				toRemove.push_back(bi);
+			}
+		}
+		for (auto* bi : toRemove)
+		{
+			_save->removeItem(bi);
+		}
+
+		hitTile(dest, damage, type);
 	}
 
 	// now detonate the tiles affected by explosion
 	if (type->ToTile > 0.0f)
 	{
-		for (auto& pair : tilesAffected)
+		std::sort(tilesAffected.begin(), tilesAffected.end(), [](const AffectedTile& a, const AffectedTile& b) { return a.tileIndex < b.tileIndex; });
+		for (const auto& affected : tilesAffected)
 		{
-			if (detonate(pair.first, pair.second))
+			Tile *tile = _save->getTile(affected.tileIndex);
+			if (detonate(tile, affected.tileDamage))
 			{
 				_save->addDestroyedObjective();
 			}
-			applyGravity(pair.first);
-			Tile *j = _save->getTile(pair.first->getPosition() + Position(0,0,1));
+			applyGravity(tile);
+			Tile *j = _save->getTile(tile->getPosition() + Position(0,0,1));
 			if (j)
 				applyGravity(j);
 		}
@@ -4670,7 +4912,6 @@ int TileEngine::unitOpensDoor(BattleUnit *unit, bool rClick, int dir)
 				calculateLighting(LL_FIRE, doorCentre, doorsOpened, true);
 				// Update FOV through the doorway.
 				calculateFOV(doorCentre, doorsOpened, true, true);
-				resetVisibilityCache();
 				unit->updateEnemyKnowledge(_save->getTileIndex(unit->getPosition()), true, true);
 			}
 			else return 4;
@@ -4752,8 +4993,6 @@ int TileEngine::closeUfoDoors()
 		}
 		doorsclosed += _save->getTile(i)->closeUfoDoor();
 	}
-	if(doorsclosed > 0)
-		resetVisibilityCache();
 	return doorsclosed;
 }
 
@@ -5024,36 +5263,16 @@ VoxelType TileEngine::voxelCheck(Position voxel, BattleUnit *excludeUnit, bool e
 		_cacheTileBelow = tileBelow;
  	}
 
-	if (tile->isVoid() && tile->getUnit() == 0 && (!tileBelow || tileBelow->getUnit() == 0))
-	{
-		return V_EMPTY;
-	}
-
-	if (tile->hasGravLiftFloor() && (voxel.z % 24 == 0 || voxel.z % 24 == 1))
+	// first we check terrain voxel data, not to allow 2x2 units stick through walls
+	const VoxelType terrain = _voxelOccupancy.check(voxel, _save->getTileIndex(pos));
+	if (terrain != V_EMPTY)
 	{
-		if (!(tileBelow && tileBelow->hasGravLiftFloor()))
-		{
-			return V_FLOOR;
-		}
+		return terrain;
 	}
 
-	// first we check terrain voxel data, not to allow 2x2 units stick through walls
-	for (int i = V_FLOOR; i <= V_OBJECT; ++i)
+	if (tile->getUnit() == 0 && (!tileBelow || tileBelow->getUnit() == 0))
 	{
-		TilePart tp = (TilePart)i;
-		MapData *mp = tile->getMapData(tp);
-		if (((tp == O_WESTWALL) || (tp == O_NORTHWALL)) && tile->isUfoDoorOpen(tp))
-			continue;
-		if (mp != 0)
-		{
-			int x = 15 - voxel.x%16;
-			int y = voxel.y%16;
-			int idx = (mp->getLoftID((voxel.z%24)/2)*16) + y;
-			if (_voxelData->at(idx) & (1 << x))
-			{
-				return (VoxelType)i;
-			}
-		}
+		return V_EMPTY;
 	}
 
 	if (!excludeAllUnits)
@@ -5106,6 +5325,41 @@ void TileEngine::voxelCheckFlush()
 	_cacheTileBelow = 0;
 }
 
+/**
+ * Updates terrain occupancy of a tile, need be called when any part of tile or state of ufo door change.
+ * @param tile Tile that changed.
+ */
+void TileEngine::tileTerrainChanged(Tile *tile)
+{
+	_voxelOccupancy.update(tile);
+	_visibilityMemo.invalidate(tile->getPosition());
+	++_terrainRevision;
+}
+
+/**
+ * Invalidates cached visibility data around tiles that unit left and entered.
+ * @param unit Unit that moved.
+ * @param oldTile Tile where unit was before, can be null.
+ */
+void TileEngine::unitTileChanged(BattleUnit *unit, Tile *oldTile)
+{
+	const int size = unit->getArmor()->getSize();
+	for (Tile *t : { oldTile, unit->getTile() })
+	{
+		if (t)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				for (int y = 0; y < size; ++y)
+				{
+					_visibilityMemo.invalidate(t->getPosition() + Position(x, y, 0));
+				}
+			}
+		}
+	}
+	++_terrainRevision;
+}
+
 /**
  * Toggles personal lighting on / off.
  */
@@ -6253,6 +6507,8 @@ bool TileEngine::validateThrow(BattleAction &action, Position originVoxel, Posit
  */
 void TileEngine::recalculateFOV()
 {
+	PhaseTimer::Scope phaseScope(TP_FOV);
+	++_viewRevision;
 	for (auto* bu : *_save->getUnits())
 	{
 		if (bu->getTile() != 0)
@@ -6677,11 +6933,22 @@ bool TileEngine::isNearDoor(Tile* tile)
 	return false;
 }
 
-std::set<Tile*> TileEngine::visibleTilesFrom(BattleUnit* unit, Position pos, int direction, bool onlyNew, bool ignoreAirTiles)
+/**
+ * Finds tiles that would be visible from a specific location.
+ * Battle is only read, so with own `marks` for each thread it can be called from worker threads,
+ * but then `reserveTilesInFOV` need be called for this unit size before workers start.
+ * @param unit Unit that would look.
+ * @param pos Position of unit.
+ * @param direction Direction unit would look.
+ * @param onlyNew Skip tiles already explored this turn.
+ * @param ignoreAirTiles Skip tiles without floor.
+ * @param marks Scratch buffer for lines, null to use one owned by tile engine (main thread only).
+ * @return Set of visible tiles.
+ */
+std::set<Tile*> TileEngine::visibleTilesFrom(BattleUnit* unit, Position pos, int direction, bool onlyNew, bool ignoreAirTiles, TileRayFan::Marks* marks)
 {
 	std::set<Tile*> visibleFrom;
 
-	std::vector<Position> _trajectory;
 	bool swap = (direction == 0 || direction == 4);
 	const int signX[8] = {+1, +1, +1, +1, -1, -1, -1, -1};
 	const int signY[8] = {-1, -1, -1, +1, +1, +1, -1, -1};
@@ -6712,6 +6979,7 @@ std::set<Tile*> TileEngine::visibleTilesFrom(BattleUnit* unit, Position pos, int
 		if (scaleFactor < 1)
 			maxDist *= scaleFactor;
 	}
+	std::vector<Position> targets;
 	for (int x = 0; x <= maxDist; ++x) // TODO: Possible improvement: find the intercept points of the arc at max view distance and choose a more intelligent sweep of values when an event arc is defined.
 	{
 		if (direction & 1)
@@ -6727,11 +6995,11 @@ std::set<Tile*> TileEngine::visibleTilesFrom(BattleUnit* unit, Position pos, int
 		for (int y = y1; y <= y2; ++y) // TODO: Possible improvement: find the intercept points of the arc at max view distance and choose a more intelligent sweep of values when an event arc is defined.
 		{
 			const int distanceSqr = x * x + y * y;
-			if (distanceSqr >= 0)
+			// lines to tiles out of view range do not reveal anything
+			if (x <= getMaxViewDistance() && y <= getMaxViewDistance() && distanceSqr <= getMaxViewDistanceSq())
 			{
 				posTest.x = pos.x + signX[direction] * (swap ? y : x);
 				posTest.y = pos.y + signY[direction] * (swap ? x : y);
-				// Only continue if the column of tiles at (x,y) is within the narrow arc of interest (if enabled)
 				for (int z = 0; z < _save->getMapSizeZ(); z++)
 				{
 					posTest.z = z;
@@ -6744,68 +7012,45 @@ std::set<Tile*> TileEngine::visibleTilesFrom(BattleUnit* unit, Position pos, int
 							if (_save->getTile(posTest)->hasNoFloor())
 								continue;
 						}
-						// this sets tiles to discovered if they are in LOS - tile visibility is not calculated in voxelspace but in tilespace
-						// large units have "4 pair of eyes"
-						int size = unit->getArmor()->getSize();
-						for (int xo = 0; xo < size; xo++)
-						{
-							for (int yo = 0; yo < size; yo++)
-							{
-								Position poso = pos + Position(xo, yo, 0);
-								_trajectory.clear();
-								int tst = calculateLineTile(poso, posTest, _trajectory);
-								if (tst > 127)
-								{
-									// Vision impacted something before reaching posTest. Throw away the impact point.
-									_trajectory.pop_back();
-								}
-								// Reveal all tiles along line of vision. Note: needed due to width of bresenham stroke.
-								for (const auto& posVisited : _trajectory)
-								{
-									// Add tiles to the visible list only once. BUT we still need to calculate the whole trajectory as
-									//  this bresenham line's period might be different from the one that originally revealed the tile.
-									if (x <= getMaxViewDistance() && y <= getMaxViewDistance() && distanceSqr <= getMaxViewDistanceSq())
-									{
-										Tile* tile = _save->getTile(posVisited);
-										if (tile->getUnit())
-											continue;
-										if (!onlyNew || tile->getLastExplored(unit->getFaction()) < _save->getTurn())
-											visibleFrom.insert(tile);
-									}
-								}
-							}
-						}
+						targets.push_back(posTest);
 					}
 				}
 			}
 		}
 	}
-	return visibleFrom;
-}
-
-void TileEngine::setVisibilityCache(Position from, Position to, bool visible)
-{
-	std::pair<int, int> key = std::make_pair(_save->getTileIndex(from), _save->getTileIndex(to));
-	_visibilityCache.insert({key, visible});
-}
-
-bool TileEngine::getVisibilityCache(Position from, Position to)
-{
-	std::pair<int, int> key = std::make_pair(_save->getTileIndex(from), _save->getTileIndex(to));
-	return _visibilityCache[key];
-}
 
-bool TileEngine::hasEntry(Position from, Position to)
-{
-	std::pair<int, int> key = std::make_pair(_save->getTileIndex(from), _save->getTileIndex(to));
-	if (_visibilityCache.find(key) != _visibilityCache.end())
-		return true;
-	return false;
+	// large units have "4 pair of eyes"
+	const int size = unit->getArmor()->getSize();
+	if (!marks)
+	{
+		reserveTilesInFOV(size);
+		marks = &_rayFanMarks;
+	}
+	std::vector<Tile*> visibleTiles;
+	for (int xo = 0; xo < size; xo++)
+	{
+		for (int yo = 0; yo < size; yo++)
+		{
+			visibleTiles.clear();
+			traceTilesInFOV(pos + Position(xo, yo, 0), targets, visibleTiles, *marks);
+			for (auto* tile : visibleTiles)
+			{
+				if (tile->getUnit())
+					continue;
+				if (!onlyNew || tile->getLastExplored(unit->getFaction()) < _save->getTurn())
+					visibleFrom.insert(tile);
+			}
+		}
+	}
+	return visibleFrom;
 }
 
+/**
+ * Empties the visibility memo, call when something other than terrain or unit positions changed.
+ */
 void TileEngine::resetVisibilityCache()
 {
-	_visibilityCache.clear();
+	_visibilityMemo.flush();
 }
 
 }
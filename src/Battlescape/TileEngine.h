@@ -20,6 +20,12 @@
 #include <vector>
 #include <set>
 #include "Position.h"
+#include "VoxelOccupancy.h"
+#include "VisibilityMemo.h"
+#include "TileRayFan.h"
+#include "UnitGrid.h"
+#include "LightSourceCache.h"
+#include "ExplosionRayFan.h"
 #include "BattlescapeGame.h"
 #include "../Mod/RuleItem.h"
 #include "../Mod/MapData.h"
@@ -59,6 +65,8 @@ public:
 	static constexpr Position voxelTileSize = { Position::TileXY, Position::TileXY, Position::TileZ };
 	/// Half of size of tile in voxels
 	static constexpr Position voxelTileCenter = { Position::TileXY / 2, Position::TileXY / 2, Position::TileZ / 2 };
+	/// Max number of lines traced together by `traceVoxelRays`.
+	static constexpr int MaxBatchRays = 32;
 
 	/// Calculate distance of each step of trajectory.
 	static float trajectoryStepSize(const std::vector<Position>& voxelPath, size_t pos)
@@ -103,9 +111,32 @@ private:
 		int count;
 	};
 
+	/**
+	 * Helper struct with power of explosion that reached a tile, in order of casting rays.
+	 */
+	struct ExplosionTile
+	{
+		/// Tile was not reached by current explosion.
+		static constexpr Uint32 NotVisited = 0xFFFFFFFF;
+
+		Uint32 firstVisit;
+		int firstPower;
+		int tileDamage;
+	};
+
+	/**
+	 * Helper struct with explosion state at one node of ray fan.
+	 */
+	struct ExplosionNode
+	{
+		Tile *tile;
+		int power;
+	};
+
 	SavedBattleGame *_save;
 	const std::vector<Uint16> *_voxelData;
 	std::vector<VisibilityBlockCache> _blockVisibility;
+	VoxelOccupancy _voxelOccupancy;
 	const RuleInventory *_inventorySlotGround;
 	constexpr static int heightFromCenter[13] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-10,+10,-12,+12};
 	bool _personalLighting;
@@ -122,13 +153,29 @@ private:
 	Position _eventVisibilitySectorL, _eventVisibilitySectorR, _eventVisibilityObserverPos;
 	std::vector<BattleUnit*> _movingUnitPrev;
 	BattleUnit* _movingUnit = nullptr;
-	std::map<std::pair<int, int>, bool> _visibilityCache;
+	VisibilityMemo _visibilityMemo;
+	Uint32 _viewRevision = 0;
+	Uint32 _terrainRevision = 0;
+	TileRayFan _rayFan;
+	TileRayFan::Marks _rayFanMarks;
+	UnitGrid _unitGrid;
+	LightSourceCache _lightSourceCache;
+	Position _reactionFovPosition;
+	ExplosionRayFan _explosionFan;
+	std::vector<ExplosionTile> _explosionTiles;
+	std::vector<ExplosionNode> _explosionNodes;
+	std::vector<int> _explosionTouched;
 
 	/// Add light source.
 	void addLight(MapSubset gs, Position center, int power, LightLayers layer);
+	/// Traces all tiles lit by light source.
+	void calculateLightContribution(MapSubset gs, Position center, int power, LightLayers layer, std::vector<LightContribution>& tiles);
 	/// Calculate blockage amount.
 	int blockage(Tile *tile, const TilePart part, ItemDamageType type, int direction = -1, bool checkingFromOrigin = false);
 
+	/// Finds tiles seen from eye by lines to given targets.
+	void traceTilesInFOV(Position eye, const std::vector<Position>& targets, std::vector<Tile*>& visible, TileRayFan::Marks& marks);
+
 	bool setupEventVisibilitySector(const Position &observerPos, const Position &eventPos, const int &eventRadius);
 	inline bool inEventVisibilitySector(const Position &toCheck) const;
 
@@ -141,10 +188,13 @@ private:
 	/// Recalculates lighting of the battlescape for units.
 	void calculateUnitLighting(MapSubset gs);
 
+	/// Scans unit's % exposure on a tile, without using memo.
+	double scanVoxelExposure(Position *originVoxel, Tile *tile, BattleUnit *excludeUnit, bool isDebug, std::vector<Position> *exposedVoxels, std::vector<Position> *coveredVoxels, bool isSimpleMode);
+
 	/// Checks validity of a snap shot to this position.
 	ReactionScore determineReactionType(BattleUnit *unit, BattleUnit *target);
 	/// Creates a vector of units that can spot this unit.
-	std::vector<ReactionScore> getSpottingUnits(BattleUnit* unit);
+	std::vector<ReactionScore> getSpottingUnits(BattleUnit* unit, bool fovKnown);
 	/// Given a vector of spotters, and a unit, picks the spotter with the highest reaction score.
 	ReactionScore *getReactor(std::vector<ReactionScore> &spotters, BattleUnit *unit);
 	/// Tries to perform a reaction snap shot to this location.
@@ -202,6 +252,8 @@ public:
 	int calculateLineTile(Position origin, Position target, std::vector<Position> &trajectory, int minLightBlock = 0);
 	/// Calculates a line trajectory in voxel space.
 	VoxelType calculateLineVoxel(Position origin, Position target, bool storeTrajectory, std::vector<Position> *trajectory, BattleUnit *excludeUnit, BattleUnit *excludeAllBut = 0, bool onlyVisible = false);
+	/// Traces multiple lines from one origin together, without storing trajectories.
+	void traceVoxelRays(Position origin, const Position *targets, int count, BattleUnit *excludeUnit, VoxelType *results, Position *impacts);
 	/// Calculates a parabola trajectory.
 	int calculateParabolaVoxel(Position origin, Position target, bool storeTrajectory, std::vector<Position> *trajectory, BattleUnit *excludeUnit, double curvature, const Position delta);
 	/// Gets the origin voxel of a unit's eyesight.
@@ -274,6 +326,10 @@ public:
 	VoxelType voxelCheck(Position voxel, BattleUnit *excludeUnit, bool excludeAllUnits = false, bool onlyVisible = false, BattleUnit *excludeAllBut = 0);
 	/// Flushes cache of voxel check
 	void voxelCheckFlush();
+	/// Updates cached terrain data after tile parts or doors changed.
+	void tileTerrainChanged(Tile *tile);
+	/// Updates cached data after unit moved to other tile.
+	void unitTileChanged(BattleUnit *unit, Tile *oldTile);
 	/// Blows this tile up.
 	bool detonate(Tile* tile, int power);
 	/// Validates a throwing action.
@@ -299,16 +355,20 @@ public:
 	bool isNextToDoor(Tile *tile, bool flipDoor = false);
 	/// Checks if any tiles around this tile are next to a door
 	bool isNearDoor(Tile* tile);
+	/// Prepares lines of tile FOV for units of given size.
+	void reserveTilesInFOV(int unitSize);
 	/// Returns a vector of tiles that would be visible from a specific location
-	std::set<Tile*> visibleTilesFrom(BattleUnit* unit, Position pos, int direction, bool onlyNew = false, bool ignoreAirTiles = true);
-	/// remember how the visibility from a specific position to another would be
-	void setVisibilityCache(Position from, Position to, bool visible);
-	/// recall how the visibility from a specific position to another was
-	bool getVisibilityCache(Position from, Position to);
-	/// checks whether there's an entry for a specific position-pair
-	bool hasEntry(Position from, Position to);
-	/// empties the visibility cache, call whenever a door is opened or destructive terrain is destroyed
+	std::set<Tile*> visibleTilesFrom(BattleUnit* unit, Position pos, int direction, bool onlyNew = false, bool ignoreAirTiles = true, TileRayFan::Marks* marks = nullptr);
+	/// Gets memo of visibility and exposure checks.
+	VisibilityMemo &getVisibilityMemo() { return _visibilityMemo; }
+	/// Gets cache of tiles lit by light sources.
+	LightSourceCache &getLightSourceCache() { return _lightSourceCache; }
+	/// empties the visibility memo, regions that changed are invalidated automatically.
 	void resetVisibilityCache();
+	/// Gets counter of lighting and FOV recalculations, it grows each time shading or visibility of tiles could change.
+	Uint32 getViewRevision() const { return _viewRevision; }
+	/// Gets counter of terrain and unit position changes, it grows each time something that can block line of fire changes.
+	Uint32 getTerrainRevision() const { return _terrainRevision; }
 };
 
 }
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include "TileRayFan.h"
+#include "LineHelper.h"
+#include "Pathfinding.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Helper struct used while building tree.
+ */
+struct BuildNode
+{
+	Position offset;
+	std::vector<int> children;
+};
+
+/**
+ * Stores subtree of build node in preorder.
+ */
+void flattenNode(const std::vector<BuildNode>& build, int index, int parent, std::vector<TileRayFan::Node>& nodes, std::vector<Sint32>& nodeOfBuild)
+{
+	const int self = (int)nodes.size();
+	const Position step = parent >= 0 ? build[index].offset - nodes[parent].offset : Position(0, 0, 0);
+	TileRayFan::Node node = { };
+	node.offset = build[index].offset;
+	node.step = step;
+	node.dir = (Sint8)Pathfinding::vectorToDirection(step);
+	node.parent = parent;
+	nodes.push_back(node);
+	nodeOfBuild[index] = self;
+	for (int child : build[index].children)
+	{
+		flattenNode(build, child, self, nodes, nodeOfBuild);
+	}
+	nodes[self].end = (Sint32)nodes.size();
+}
+
+}
+
+/**
+ * Creates empty fan, it need `reserve` before use.
+ */
+TileRayFan::TileRayFan()
+{
+
+}
+
+/**
+ * Cleans up the fan.
+ */
+TileRayFan::~TileRayFan()
+{
+
+}
+
+/**
+ * Gets index of offset in table of targets.
+ * @param offset Offset from origin.
+ * @return Index or -1 if outside of fan.
+ */
+int TileRayFan::getTargetIndex(Position offset) const
+{
+	if (std::abs(offset.x) > _radius || std::abs(offset.y) > _radius || std::abs(offset.z) >= _levels)
+	{
+		return -1;
+	}
+	const int side = _radius * 2 + 1;
+	return ((offset.z + _levels - 1) * side + (offset.y + _radius)) * side + (offset.x + _radius);
+}
+
+/**
+ * Builds lines to all tiles in circle of given radius and on all levels of map.
+ * Fan is only rebuilt when it does not cover requested range yet.
+ * @param radius Radius of circle in tiles.
+ * @param levels Number of levels of map.
+ */
+void TileRayFan::reserve(int radius, int levels)
+{
+	if (covers(radius, levels))
+	{
+		return;
+	}
+	_radius = radius;
+	_levels = levels;
+
+	const int side = _radius * 2 + 1;
+	std::vector<BuildNode> build;
+	std::vector<int> buildTargets(side * side * (_levels * 2 - 1), -1);
+	build.push_back(BuildNode{ Position(0, 0, 0), { } });
+
+	const Position origin = Position(0, 0, 0);
+	for (int z = 1 - _levels; z < _levels; ++z)
+	{
+		for (int y = -_radius; y <= _radius; ++y)
+		{
+			for (int x = -_radius; x <= _radius; ++x)
+			{
+				if (x * x + y * y > _radius * _radius)
+				{
+					continue;
+				}
+				const Position target = Position(x, y, z);
+				int current = -1;
+				calculateLineHelper(origin, target,
+					[&](Position point)
+					{
+						if (current == -1)
+						{
+							// first point is always origin
+							current = 0;
+							return false;
+						}
+						for (int child : build[current].children)
+						{
+							if (build[child].offset == point)
+							{
+								current = child;
+								return false;
+							}
+						}
+						const int added = (int)build.size();
+						build.push_back(BuildNode{ point, { } });
+						build[current].children.push_back(added);
+						current = added;
+						return false;
+					},
+					[&](Position)
+					{
+						return false;
+					}
+				);
+				buildTargets[getTargetIndex(target)] = current;
+			}
+		}
+	}
+
+	std::vector<Sint32> nodeOfBuild(build.size(), -1);
+	_nodes.clear();
+	_nodes.reserve(build.size());
+	flattenNode(build, 0, -1, _nodes, nodeOfBuild);
+
+	_targets.assign(buildTargets.size(), -1);
+	for (size_t i = 0; i < buildTargets.size(); ++i)
+	{
+		if (buildTargets[i] >= 0)
+		{
+			_targets[i] = nodeOfBuild[buildTargets[i]];
+		}
+	}
+}
+
+/**
+ * Removes all marks of previous query, cost depend only on number of marked nodes.
+ * Marks made for older fan (before it was rebuilt) are replaced by empty ones.
+ * @param marks Marks to clear.
+ */
+void TileRayFan::clearMarks(Marks& marks) const
+{
+	if (marks._marks.size() != _nodes.size())
+	{
+		marks._marks.assign(_nodes.size(), 0);
+		marks._touched.clear();
+		return;
+	}
+	for (Sint32 i : marks._touched)
+	{
+		marks._marks[i] = 0;
+	}
+	marks._touched.clear();
+}
+
+/**
+ * Requests line from origin to given offset, all nodes on it are marked.
+ * Walk up stops on first node that is already marked as path of other line.
+ * @param marks Marks of current query, need be cleared by `clearMarks` first.
+ * @param offset Target relative to origin, need be inside of reserved range.
+ */
+void TileRayFan::markTarget(Marks& marks, Position offset) const
+{
+	const int index = getTargetIndex(offset);
+	if (index < 0 || _targets[index] < 0)
+	{
+		return;
+	}
+	Sint32 node = _targets[index];
+	if (!marks._marks[node])
+	{
+		marks._touched.push_back(node);
+	}
+	marks._marks[node] |= MarkTarget;
+	for (node = _nodes[node].parent; node >= 0 && !(marks._marks[node] & MarkPath); node = _nodes[node].parent)
+	{
+		if (!marks._marks[node])
+		{
+			marks._touched.push_back(node);
+		}
+		marks._marks[node] |= MarkPath;
+	}
+}
+
+}
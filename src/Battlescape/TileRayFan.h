@@ -0,0 +1,124 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Precomputed fan of tile lines used by field of view.
+ * Bresenham lines from origin to every tile in range are merged into a tree by their common beginning,
+ * so tile near observer is checked once for all lines passing it, not once per line.
+ * Tree is stored in preorder and each node knows where its subtree ends,
+ * so a blocked branch is skipped by one jump.
+ * Lines are translation invariant, so same tree serve every observer.
+ * Fan is not changed by queries, lines requested by one query are marked in separate `Marks`,
+ * so any number of threads can trace it at once, each with its own marks.
+ */
+class TileRayFan
+{
+public:
+	/**
+	 * One step of line, shared by all lines that have same beginning.
+	 */
+	struct Node
+	{
+		/// Position of tile relative to origin.
+		Position offset;
+		/// Difference from previous tile of line.
+		Position step;
+		/// Direction from previous tile of line, -1 for vertical step or origin.
+		Sint8 dir;
+		/// Index of previous node, -1 for origin.
+		Sint32 parent;
+		/// Index of first node after subtree of this node.
+		Sint32 end;
+	};
+
+	/// Node is end of some line requested by current query.
+	static constexpr Uint8 MarkTarget = 1;
+	/// Some requested line pass through node.
+	static constexpr Uint8 MarkPath = 2;
+
+	/**
+	 * Lines requested by one query, owned by caller of query.
+	 */
+	class Marks
+	{
+		friend class TileRayFan;
+
+		std::vector<Uint8> _marks;
+		std::vector<Sint32> _touched;
+	};
+
+private:
+	std::vector<Node> _nodes;
+	std::vector<Sint32> _targets;
+	int _radius = -1, _levels = 0;
+
+	/// Gets index in table of targets.
+	int getTargetIndex(Position offset) const;
+
+public:
+	/// Creates empty fan.
+	TileRayFan();
+	/// Cleans up the fan.
+	~TileRayFan();
+
+	/// Makes sure fan cover given range, rebuilds it if needed.
+	void reserve(int radius, int levels);
+	/// Checks if fan cover given range without rebuilding.
+	bool covers(int radius, int levels) const { return radius <= _radius && levels == _levels; }
+	/// Removes all marks of previous query.
+	void clearMarks(Marks& marks) const;
+	/// Requests line from origin to given offset.
+	void markTarget(Marks& marks, Position offset) const;
+
+	/// Gets number of nodes in fan.
+	int getNodesCount() const { return (int)_nodes.size(); }
+
+	/**
+	 * Walks all requested lines together.
+	 * @param marks Lines requested by query.
+	 * @param func Called for each node on requested lines with node and `MarkTarget` flag,
+	 *  returns true if lines can continue past this node.
+	 */
+	template<typename Func>
+	void trace(const Marks& marks, Func func) const
+	{
+		const int size = (int)_nodes.size();
+		for (int i = 0; i < size; )
+		{
+			const Uint8 mark = marks._marks[i];
+			if (mark && func(_nodes[i], (mark & MarkTarget) != 0))
+			{
+				++i;
+			}
+			else
+			{
+				i = _nodes[i].end;
+			}
+		}
+	}
+};
+
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include "UnitGrid.h"
+#include "../Savegame/BattleUnit.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates empty grid.
+ */
+UnitGrid::UnitGrid()
+{
+
+}
+
+/**
+ * Cleans up the grid, units that outlive it forget it.
+ */
+UnitGrid::~UnitGrid()
+{
+	init(0, 0);
+}
+
+/**
+ * Sets size of map and removes all units.
+ * @param mapSizeX Width of map in tiles.
+ * @param mapSizeY Length of map in tiles.
+ */
+void UnitGrid::init(int mapSizeX, int mapSizeY)
+{
+	for (auto& cell : _cells)
+	{
+		for (auto& entry : cell)
+		{
+			entry.unit->setUnitGrid(nullptr);
+		}
+	}
+	_cellsX = (mapSizeX + CellSize - 1) / CellSize;
+	_cellsY = (mapSizeY + CellSize - 1) / CellSize;
+	_cells.clear();
+	_cells.resize(_cellsX * _cellsY);
+	_count = 0;
+	_nextOrder = 0;
+}
+
+/**
+ * Gets index of cell containing position, positions outside of map are clamped to border.
+ * @param pos Position of unit.
+ * @return Index of cell.
+ */
+int UnitGrid::getCell(Position pos) const
+{
+	const int x = std::min(std::max(pos.x / CellSize, 0), _cellsX - 1);
+	const int y = std::min(std::max(pos.y / CellSize, 0), _cellsY - 1);
+	return y * _cellsX + x;
+}
+
+/**
+ * Adds unit to grid, units must be added in order they are stored in battle.
+ * @param unit Unit.
+ */
+void UnitGrid::insert(BattleUnit *unit)
+{
+	unit->setUnitGrid(this);
+	_cells[getCell(unit->getPosition())].push_back(Entry{ _nextOrder++, unit });
+	++_count;
+}
+
+/**
+ * Adds all units that are not in grid yet.
+ * Units are only appended to battle or deleted (what remove them from grid),
+ * so nothing need be done while number of units match, and new units always
+ * come after all units already in grid.
+ * @param units All units of battle.
+ */
+void UnitGrid::sync(const std::vector<BattleUnit*> &units)
+{
+	if (_cells.empty() || units.size() == _count)
+	{
+		return;
+	}
+	for (auto* unit : units)
+	{
+		if (unit->getUnitGrid() != this)
+		{
+			insert(unit);
+		}
+	}
+}
+
+/**
+ * Moves unit to cell of its new position.
+ * @param unit Unit.
+ * @param from Old position of unit.
+ * @param to New position of unit.
+ */
+void UnitGrid::move(BattleUnit *unit, Position from, Position to)
+{
+	const int oldCell = getCell(from);
+	const int newCell = getCell(to);
+	if (oldCell != newCell)
+	{
+		auto& cell = _cells[oldCell];
+		auto it = std::find_if(cell.begin(), cell.end(), [&](const Entry &e) { return e.unit == unit; });
+		if (it != cell.end())
+		{
+			_cells[newCell].push_back(*it);
+			cell.erase(it);
+		}
+	}
+}
+
+/**
+ * Removes unit from grid.
+ * @param unit Unit.
+ */
+void UnitGrid::remove(BattleUnit *unit)
+{
+	auto& cell = _cells[getCell(unit->getPosition())];
+	auto it = std::find_if(cell.begin(), cell.end(), [&](const Entry &e) { return e.unit == unit; });
+	if (it != cell.end())
+	{
+		cell.erase(it);
+	}
+	unit->setUnitGrid(nullptr);
+	--_count;
+}
+
+/**
+ * Finds units in cells that overlap square around center, result still need be filtered by exact distance.
+ * Units are sorted in order they are stored in battle, so order does not depend on how they moved between cells.
+ * @param center Center of area.
+ * @param radius Half of side of square in tiles.
+ * @param result Found units are added there.
+ */
+void UnitGrid::find(Position center, int radius, std::vector<BattleUnit*> &result) const
+{
+	if (_cells.empty())
+	{
+		return;
+	}
+	const int minX = getCell(Position(center.x - radius, 0, 0)) % _cellsX;
+	const int maxX = getCell(Position(center.x + radius, 0, 0)) % _cellsX;
+	const int minY = getCell(Position(0, center.y - radius, 0)) / _cellsX;
+	const int maxY = getCell(Position(0, center.y + radius, 0)) / _cellsX;
+	std::vector<Entry> found;
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			const auto& cell = _cells[y * _cellsX + x];
+			found.insert(found.end(), cell.begin(), cell.end());
+		}
+	}
+	std::sort(found.begin(), found.end(), [](const Entry &a, const Entry &b) { return a.order < b.order; });
+	result.reserve(result.size() + found.size());
+	for (auto& entry : found)
+	{
+		result.push_back(entry.unit);
+	}
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+class BattleUnit;
+
+/**
+ * Uniform grid of units bucketed by their position, used to find observers near an event
+ * without scanning every unit of battle.
+ * Unit is added on first query after it appears in battle and then it moves with `BattleUnit::setPosition`.
+ * Units outside of map are kept in nearest border cell.
+ */
+class UnitGrid
+{
+public:
+	/// Size in tiles of one side of cell.
+	static constexpr int CellSize = 8;
+
+private:
+	/// Unit in cell with its place in order of units of battle.
+	struct Entry
+	{
+		size_t order;
+		BattleUnit *unit;
+	};
+
+	std::vector<std::vector<Entry>> _cells;
+	int _cellsX = 0, _cellsY = 0;
+	size_t _count = 0;
+	size_t _nextOrder = 0;
+
+	/// Gets index of cell containing position.
+	int getCell(Position pos) const;
+	/// Adds unit to grid.
+	void insert(BattleUnit *unit);
+
+public:
+	/// Creates empty grid.
+	UnitGrid();
+	/// Cleans up the grid.
+	~UnitGrid();
+
+	/// Sets size of map and removes all units.
+	void init(int mapSizeX, int mapSizeY);
+	/// Adds all units that are not in grid yet.
+	void sync(const std::vector<BattleUnit*> &units);
+	/// Moves unit to cell of its new position.
+	void move(BattleUnit *unit, Position from, Position to);
+	/// Removes unit from grid.
+	void remove(BattleUnit *unit);
+	/// Finds units in cells that overlap square around center.
+	void find(Position center, int radius, std::vector<BattleUnit*> &result) const;
+};
+
+}
@@ -37,8 +37,9 @@ namespace OpenXcom
  * @param height Height in pixels.
  * @param x X position in pixels.
  * @param y Y position in pixels.
+ * @param cache Optional cache of composed frames.
  */
-UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, int red, int blue) :
+UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, int red, int blue, UnitSpriteCache* cache) :
 	_unit(0), _itemR(0), _itemL(0),
 	_unitSurface(0),
 	_itemSurface(const_cast<Mod*>(mod)->getSurfaceSet("HANDOB.PCK")),
@@ -50,7 +51,8 @@ UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* sav
 	_helmet(helmet),
 	_red(red), _blue(blue),
 	_x(0), _y(0), _shade(0), _burn(0),
-	_mask(0, 0)
+	_mask(0, 0),
+	_cache(cache), _cacheKey(), _collectParts(false), _cacheable(false)
 {
 
 }
@@ -147,6 +149,12 @@ void UnitSprite::blitItem(Part& item)
 	ScriptWorkerBlit work;
 	BattleItem::ScriptFill(&work, (item.bodyPart == BODYPART_ITEM_RIGHTHAND ? _itemR : _itemL), _save, item.bodyPart, _animationFrame, _shade);
 
+	if (_collectParts)
+	{
+		collectPart(item, work);
+		return;
+	}
+
 	_dest->lock();
 
 	work.executeBlit(item.src, _dest,  _x + item.offX, _y + item.offY, _shade, _mask);
@@ -167,6 +175,12 @@ void UnitSprite::blitBody(Part& body)
 	ScriptWorkerBlit work;
 	BattleUnit::ScriptFill(&work, _unit, _save, body.bodyPart, _animationFrame, _shade, _burn);
 
+	if (_collectParts)
+	{
+		collectPart(body, work);
+		return;
+	}
+
 	_dest->lock();
 
 	work.executeBlit(body.src, _dest,  _x + body.offX, _y + body.offY, _shade, _mask);
@@ -174,6 +188,104 @@ void UnitSprite::blitBody(Part& body)
 	_dest->unlock();
 }
 
+/**
+ * Remember part that will be drawn on composed frame, instead of blitting it.
+ * Frame can't be cached if any recolor script reads pixels that are already on surface.
+ * Animation frame and burn are only script arguments, so key includes them only when part have script.
+ * @param part Part of sprite.
+ * @param work Script worker that would blit this part.
+ */
+void UnitSprite::collectPart(const Part& part, ScriptWorkerBlit& work)
+{
+	if (_cacheKey.partsCount >= UnitSpriteCacheKey::PartsMax || !work.isDestIndependent())
+	{
+		_cacheable = false;
+		return;
+	}
+	if (work.hasScript())
+	{
+		_cacheKey.animationFrame = _animationFrame;
+		_cacheKey.burn = _burn;
+	}
+	UnitSpriteCachePart& p = _cacheKey.parts[_cacheKey.partsCount++];
+	p.src = part.src;
+	p.bodyPart = part.bodyPart;
+	p.offX = part.offX;
+	p.offY = part.offY;
+}
+
+/**
+ * Draws unit as one surface composed from all its parts.
+ * Drawing routine is run only to collect parts, frame is composed when it's not in cache yet.
+ * @param routine Drawing routine of unit.
+ * @return False if unit can't be cached and need be drawn part by part.
+ */
+bool UnitSprite::drawCached(void (UnitSprite::*routine)())
+{
+	_cacheKey = UnitSpriteCacheKey{};
+	_cacheKey.unit = _unit;
+	_cacheKey.itemR = _itemR;
+	_cacheKey.itemL = _itemL;
+	_cacheKey.unitId = _unit->getId();
+	_cacheKey.part = _part;
+	_cacheKey.shade = _shade;
+
+	_cacheable = true;
+	_collectParts = true;
+	(this->*routine)();
+	_collectParts = false;
+
+	if (!_cacheable)
+	{
+		return false;
+	}
+	if (_cacheKey.partsCount == 0)
+	{
+		return true;
+	}
+
+	const UnitSpriteCache::Entry *entry = _cache->find(_cacheKey);
+	if (!entry)
+	{
+		int minX = 0, minY = 0, maxX = 0, maxY = 0;
+		for (int i = 0; i < _cacheKey.partsCount; ++i)
+		{
+			const UnitSpriteCachePart& p = _cacheKey.parts[i];
+			if (i == 0 || p.offX < minX) minX = p.offX;
+			if (i == 0 || p.offY < minY) minY = p.offY;
+			if (i == 0 || p.offX + p.src->getWidth() > maxX) maxX = p.offX + p.src->getWidth();
+			if (i == 0 || p.offY + p.src->getHeight() > maxY) maxY = p.offY + p.src->getHeight();
+		}
+
+		UnitSpriteCache::Entry *newEntry = _cache->insert(_cacheKey, minX, minY, maxX - minX, maxY - minY);
+		Surface *frame = newEntry->surface.get();
+		frame->lock();
+		for (int i = 0; i < _cacheKey.partsCount; ++i)
+		{
+			const UnitSpriteCachePart& p = _cacheKey.parts[i];
+			ScriptWorkerBlit work;
+			if (p.bodyPart == BODYPART_ITEM_RIGHTHAND || p.bodyPart == BODYPART_ITEM_LEFTHAND)
+			{
+				BattleItem::ScriptFill(&work, (p.bodyPart == BODYPART_ITEM_RIGHTHAND ? _itemR : _itemL), _save, p.bodyPart, _animationFrame, _shade);
+			}
+			else
+			{
+				BattleUnit::ScriptFill(&work, _unit, _save, p.bodyPart, _animationFrame, _shade, _burn);
+			}
+			work.executeBlit(p.src, frame, p.offX - minX, p.offY - minY, _shade);
+		}
+		frame->unlock();
+		entry = newEntry;
+	}
+
+	_dest->lock();
+
+	entry->surface->blitNShade(_dest, _x + entry->offX, _y + entry->offY, 0, _mask);
+
+	_dest->unlock();
+	return true;
+}
+
 /**
  * Draws a unit, using the drawing rules of the unit.
  * This function is called by Map, for each unit on the screen.
@@ -246,7 +358,10 @@ void UnitSprite::draw(const BattleUnit* unit, int part, int x, int y, int shade,
 		&UnitSprite::drawRoutine3,
 	};
 	// Call the matching routine
-	(this->*(routines[_drawingRoutine]))();
+	if (!_cache || !drawCached(routines[_drawingRoutine]))
+	{
+		(this->*(routines[_drawingRoutine]))();
+	}
 	// draw fire
 	if (unit->getFire() > 0)
 	{
@@ -19,6 +19,7 @@
  */
 #include "../Engine/Surface.h"
 #include "../Engine/Script.h"
+#include "UnitSpriteCache.h"
 
 namespace OpenXcom
 {
@@ -60,6 +61,9 @@ private:
 	int _red, _blue;
 	int _x, _y, _shade, _burn;
 	GraphSubset _mask;
+	UnitSpriteCache *_cache;
+	UnitSpriteCacheKey _cacheKey;
+	bool _collectParts, _cacheable;
 
 	/// Drawing routine for XCom soldiers in overalls, sectoids (routine 0),
 	/// mutons (routine 10),
@@ -107,9 +111,13 @@ private:
 	void blitItem(Part& item);
 	/// Blit body sprite.
 	void blitBody(Part& body);
+	/// Remember part that will be drawn on composed frame.
+	void collectPart(const Part& part, ScriptWorkerBlit& work);
+	/// Draws unit using frame from cache.
+	bool drawCached(void (UnitSprite::*routine)());
 public:
 	/// Creates a new UnitSprite at the specified position and size.
-	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, int red, int blue);
+	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, int red, int blue, UnitSpriteCache* cache = nullptr);
 	/// Cleans up the UnitSprite.
 	~UnitSprite();
 	/// Draws the unit.
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UnitSpriteCache.h"
+#include "../Engine/Surface.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Mix bits of value into hash.
+ */
+inline size_t hashMix(size_t hash, size_t value)
+{
+	hash ^= value + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+}
+
+/**
+ * Compares all fields of key.
+ * @param other Other key.
+ * @return True if both keys describe same frame.
+ */
+bool UnitSpriteCacheKey::operator==(const UnitSpriteCacheKey& other) const
+{
+	if (unit != other.unit || itemR != other.itemR || itemL != other.itemL
+		|| unitId != other.unitId || part != other.part || animationFrame != other.animationFrame
+		|| shade != other.shade || burn != other.burn || partsCount != other.partsCount)
+	{
+		return false;
+	}
+	for (int i = 0; i < partsCount; ++i)
+	{
+		if (!(parts[i] == other.parts[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Calculates hash of key.
+ * @param key Key of frame.
+ * @return Hash.
+ */
+size_t UnitSpriteCache::KeyHash::operator()(const UnitSpriteCacheKey& key) const
+{
+	size_t hash = (size_t)key.unit;
+	hash = hashMix(hash, key.unitId);
+	hash = hashMix(hash, key.part | (key.animationFrame << 8) | (key.shade << 16) | (key.burn << 24));
+	hash = hashMix(hash, (size_t)key.itemR);
+	hash = hashMix(hash, (size_t)key.itemL);
+	for (int i = 0; i < key.partsCount; ++i)
+	{
+		hash = hashMix(hash, (size_t)key.parts[i].src);
+		hash = hashMix(hash, key.parts[i].bodyPart ^ (key.parts[i].offX << 12) ^ (key.parts[i].offY << 20));
+	}
+	return hash;
+}
+
+/**
+ * Creates empty cache.
+ */
+UnitSpriteCache::UnitSpriteCache()
+{
+
+}
+
+/**
+ * Cleans up the cache.
+ */
+UnitSpriteCache::~UnitSpriteCache()
+{
+
+}
+
+/**
+ * Finds frame composed for given key and marks it as recently used.
+ * @param key Key of frame.
+ * @return Found frame or null.
+ */
+const UnitSpriteCache::Entry *UnitSpriteCache::find(const UnitSpriteCacheKey& key)
+{
+	auto it = _index.find(key);
+	if (it == _index.end())
+	{
+		return nullptr;
+	}
+	_entries.splice(_entries.begin(), _entries, it->second);
+	return &*it->second;
+}
+
+/**
+ * Adds new frame for key, least recently used frame is dropped if cache is full.
+ * @param key Key of frame, must not be in cache yet.
+ * @param offX Position of frame relative to position of unit sprite.
+ * @param offY Position of frame relative to position of unit sprite.
+ * @param width Width of frame.
+ * @param height Height of frame.
+ * @return New frame with transparent surface.
+ */
+UnitSpriteCache::Entry *UnitSpriteCache::insert(const UnitSpriteCacheKey& key, int offX, int offY, int width, int height)
+{
+	if ((int)_entries.size() >= EntriesMax)
+	{
+		_index.erase(_entries.back().key);
+		_entries.pop_back();
+	}
+
+	_entries.emplace_front();
+	Entry& entry = _entries.front();
+	entry.key = key;
+	entry.surface = std::make_unique<Surface>(width, height);
+	entry.offX = offX;
+	entry.offY = offY;
+	_index.insert(std::make_pair(key, _entries.begin()));
+	return &entry;
+}
+
+/**
+ * Drops all frames.
+ */
+void UnitSpriteCache::clear()
+{
+	_index.clear();
+	_entries.clear();
+}
+
+}
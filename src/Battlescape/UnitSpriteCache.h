@@ -0,0 +1,122 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace OpenXcom
+{
+
+class Surface;
+class BattleUnit;
+class BattleItem;
+
+/**
+ * Part of unit sprite that was blit on composed frame.
+ */
+struct UnitSpriteCachePart
+{
+	const Surface *src = nullptr;
+	int bodyPart = 0;
+	int offX = 0;
+	int offY = 0;
+
+	bool operator==(const UnitSpriteCachePart& other) const
+	{
+		return src == other.src && bodyPart == other.bodyPart && offX == other.offX && offY == other.offY;
+	}
+};
+
+/**
+ * Everything that composed unit frame depends on.
+ * Parts are collected by running drawing routine, so they already cover armor, direction, status, walking phase and items.
+ */
+struct UnitSpriteCacheKey
+{
+	/// Max number of parts in one frame.
+	static constexpr int PartsMax = 8;
+
+	const BattleUnit *unit = nullptr;
+	const BattleItem *itemR = nullptr;
+	const BattleItem *itemL = nullptr;
+	int unitId = 0;
+	int part = 0;
+	/// Only set when some part have recolor script, otherwise idle unit would get new frame every tick.
+	int animationFrame = 0;
+	int shade = 0;
+	/// Only set when some part have recolor script.
+	int burn = 0;
+	int partsCount = 0;
+	UnitSpriteCachePart parts[PartsMax];
+
+	bool operator==(const UnitSpriteCacheKey& other) const;
+};
+
+/**
+ * Bounded cache of unit frames already composed from all body parts, items and recolor scripts.
+ * Least recently used frame is dropped when cache is full.
+ */
+class UnitSpriteCache
+{
+public:
+	/// Max number of frames stored in cache.
+	static constexpr int EntriesMax = 512;
+
+	/**
+	 * Helper struct with one composed frame.
+	 */
+	struct Entry
+	{
+		UnitSpriteCacheKey key;
+		std::unique_ptr<Surface> surface;
+		/// Position of top left corner of frame relative to position of unit sprite.
+		int offX = 0;
+		int offY = 0;
+	};
+
+private:
+	/**
+	 * Helper struct calculating hash of key.
+	 */
+	struct KeyHash
+	{
+		size_t operator()(const UnitSpriteCacheKey& key) const;
+	};
+
+	std::list<Entry> _entries;
+	std::unordered_map<UnitSpriteCacheKey, std::list<Entry>::iterator, KeyHash> _index;
+
+public:
+	/// Creates empty cache.
+	UnitSpriteCache();
+	/// Cleans up the cache.
+	~UnitSpriteCache();
+
+	/// Finds frame for key.
+	const Entry *find(const UnitSpriteCacheKey& key);
+	/// Adds new empty frame for key.
+	Entry *insert(const UnitSpriteCacheKey& key, int offX, int offY, int width, int height);
+	/// Drops all frames.
+	void clear();
+	/// Gets number of stored frames.
+	int size() const { return (int)_entries.size(); }
+};
+
+}
@@ -151,7 +151,7 @@ void UnitTurnBState::think()
 				kneel.Time = _unit->getKneelChangeCost();
 				if (kneel.spendTU())
 				{
-					_unit->kneel(!_unit->isKneeled());
+					_unit->kneel(!_unit->isKneeled(), _parent->getSave());
 					// kneeling or standing up can reveal new terrain or units. I guess.
 					_parent->getTileEngine()->calculateFOV(_unit->getPosition(), 1, false); //Update unit FOV for everyone through this position, skip tiles.
 					_parent->getTileEngine()->checkReactionFire(_unit, kneel);
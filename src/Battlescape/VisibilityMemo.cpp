@@ -0,0 +1,182 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include "VisibilityMemo.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Mix bits of value into hash.
+ */
+inline Uint64 hashMix(Uint64 hash, Uint64 value)
+{
+	hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+}
+
+/**
+ * Creates empty memo.
+ */
+VisibilityMemo::VisibilityMemo()
+{
+
+}
+
+/**
+ * Cleans up the memo.
+ */
+VisibilityMemo::~VisibilityMemo()
+{
+
+}
+
+/**
+ * Sets size of map and clears all stored values.
+ * @param mapSizeX Width of map in tiles.
+ * @param mapSizeY Length of map in tiles.
+ */
+void VisibilityMemo::init(int mapSizeX, int mapSizeY)
+{
+	_regionsX = (mapSizeX + RegionSize - 1) / RegionSize;
+	_regionsY = (mapSizeY + RegionSize - 1) / RegionSize;
+	_entries.assign(TableSize, Entry{});
+	_regionRevisions.assign(_regionsX * _regionsY, 0);
+	// empty entries have revision 0 and never match
+	_lastRevision = 1;
+	_flushRevision = 1;
+	resetStats();
+}
+
+/**
+ * Gets position in table where given key is stored.
+ * @param key Key of value.
+ * @return Index of entry.
+ */
+size_t VisibilityMemo::getSlot(const VisibilityMemoKey& key) const
+{
+	Uint64 hash = key.type;
+	hash = hashMix(hash, ((Uint64)(Uint16)key.origin.x << 32) | ((Uint64)(Uint16)key.origin.y << 16) | (Uint16)key.origin.z);
+	hash = hashMix(hash, ((Uint64)(Uint16)key.target.x << 32) | ((Uint64)(Uint16)key.target.y << 16) | (Uint16)key.target.z);
+	hash = hashMix(hash, ((Uint64)(Uint32)key.unitA << 32) | (Uint32)key.unitB);
+	hash = hashMix(hash, (Uint32)key.flags);
+	return (size_t)(hash & (TableSize - 1));
+}
+
+/**
+ * Gets newest revision of all regions that touch the area between two tiles.
+ * Area is expanded by one tile to cover big units and origins that are offset from center of tile.
+ * @param tileA First corner of area.
+ * @param tileB Second corner of area.
+ * @return Revision.
+ */
+Uint32 VisibilityMemo::getRevision(Position tileA, Position tileB) const
+{
+	const int minX = std::max(0, std::min(tileA.x, tileB.x) - 1) / RegionSize;
+	const int minY = std::max(0, std::min(tileA.y, tileB.y) - 1) / RegionSize;
+	const int maxX = std::min(_regionsX - 1, (std::max(tileA.x, tileB.x) + 1) / RegionSize);
+	const int maxY = std::min(_regionsY - 1, (std::max(tileA.y, tileB.y) + 1) / RegionSize);
+
+	Uint32 revision = _flushRevision;
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			revision = std::max(revision, _regionRevisions[y * _regionsX + x]);
+		}
+	}
+	return revision;
+}
+
+/**
+ * Invalidates all values that depend on given tile, need be called when terrain or unit on it change.
+ * @param tile Position of tile.
+ */
+void VisibilityMemo::invalidate(Position tile)
+{
+	if (_regionRevisions.empty() || tile.x < 0 || tile.y < 0)
+	{
+		return;
+	}
+	const int x = tile.x / RegionSize;
+	const int y = tile.y / RegionSize;
+	if (x < _regionsX && y < _regionsY)
+	{
+		_regionRevisions[y * _regionsX + x] = ++_lastRevision;
+	}
+}
+
+/**
+ * Invalidates all values.
+ */
+void VisibilityMemo::flush()
+{
+	_flushRevision = ++_lastRevision;
+}
+
+/**
+ * Finds value stored for key.
+ * @param key Key of value.
+ * @param tileA Tile of origin.
+ * @param tileB Tile of target.
+ * @param value Found value.
+ * @return True if value was found and is still valid.
+ */
+bool VisibilityMemo::find(const VisibilityMemoKey& key, Position tileA, Position tileB, float& value)
+{
+	if (_entries.empty())
+	{
+		return false;
+	}
+	const Entry& entry = _entries[getSlot(key)];
+	if (entry.key == key && entry.revision == getRevision(tileA, tileB))
+	{
+		value = entry.value;
+		++_hits;
+		return true;
+	}
+	++_misses;
+	return false;
+}
+
+/**
+ * Stores value for key, replaces any older value in same slot.
+ * @param key Key of value.
+ * @param tileA Tile of origin.
+ * @param tileB Tile of target.
+ * @param value Value to store.
+ */
+void VisibilityMemo::store(const VisibilityMemoKey& key, Position tileA, Position tileB, float value)
+{
+	if (_entries.empty())
+	{
+		return;
+	}
+	Entry& entry = _entries[getSlot(key)];
+	entry.key = key;
+	entry.revision = getRevision(tileA, tileB);
+	entry.value = value;
+}
+
+}
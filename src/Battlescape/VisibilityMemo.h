@@ -0,0 +1,125 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Kind of value stored in memo.
+ */
+enum VisibilityMemoType : Uint8
+{
+	VMT_EXPOSURE,
+	VMT_TILE_SIGHT,
+	VMT_CLEAR_SIGHT,
+	VMT_LINE_OF_FIRE,
+};
+
+/**
+ * Key of value stored in memo, all fields need match.
+ */
+struct VisibilityMemoKey
+{
+	/// Origin of check, voxel or tile depending on type.
+	Position origin;
+	/// Target of check.
+	Position target;
+	/// Id of unit that is ignored by check or -1.
+	int unitA = -1;
+	/// Id of target unit or -1.
+	int unitB = -1;
+	/// Additional flags that change result.
+	int flags = 0;
+	/// Kind of check.
+	VisibilityMemoType type = VMT_EXPOSURE;
+
+	bool operator==(const VisibilityMemoKey& other) const
+	{
+		return origin == other.origin && target == other.target && unitA == other.unitA && unitB == other.unitB && flags == other.flags && type == other.type;
+	}
+};
+
+/**
+ * Bounded memo of exposure and line of sight checks.
+ * Map is divided into columns of tiles, each with its own revision bumped when terrain or units in it change.
+ * Value stays valid as long as no column in area between origin and target changed,
+ * line between two points never leaves their bounding box.
+ */
+class VisibilityMemo
+{
+public:
+	/// Size in tiles of one side of region column.
+	static constexpr int RegionSize = 8;
+	/// Number of entries in memo.
+	static constexpr int TableSize = 1 << 15;
+
+private:
+	/**
+	 * Helper struct with one memorized value.
+	 */
+	struct Entry
+	{
+		VisibilityMemoKey key;
+		Uint32 revision = 0;
+		float value = 0.0f;
+	};
+
+	std::vector<Entry> _entries;
+	std::vector<Uint32> _regionRevisions;
+	int _regionsX = 0, _regionsY = 0;
+	Uint32 _lastRevision = 0;
+	Uint32 _flushRevision = 0;
+	Uint64 _hits = 0, _misses = 0;
+
+	/// Gets index of entry for key.
+	size_t getSlot(const VisibilityMemoKey& key) const;
+	/// Gets newest revision of all regions in area.
+	Uint32 getRevision(Position tileA, Position tileB) const;
+
+public:
+	/// Creates empty memo.
+	VisibilityMemo();
+	/// Cleans up the memo.
+	~VisibilityMemo();
+
+	/// Sets size of map.
+	void init(int mapSizeX, int mapSizeY);
+	/// Invalidates all values that depend on given tile.
+	void invalidate(Position tile);
+	/// Invalidates all values.
+	void flush();
+
+	/// Finds value stored for key, if nothing changed in area between both tiles.
+	bool find(const VisibilityMemoKey& key, Position tileA, Position tileB, float& value);
+	/// Stores value for key, valid until something changes in area between both tiles.
+	void store(const VisibilityMemoKey& key, Position tileA, Position tileB, float value);
+
+	/// Gets number of successful finds.
+	Uint64 getHits() const { return _hits; }
+	/// Gets number of failed finds.
+	Uint64 getMisses() const { return _misses; }
+	/// Resets statistic of finds.
+	void resetStats() { _hits = 0; _misses = 0; }
+};
+
+}
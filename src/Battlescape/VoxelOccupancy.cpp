@@ -0,0 +1,187 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "VoxelOccupancy.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/Tile.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates occupancy grid, data is not build until `rebuild` is called.
+ * @param save Pointer to battle.
+ * @param voxelData LOFT data from mod.
+ */
+VoxelOccupancy::VoxelOccupancy(SavedBattleGame *save, const std::vector<Uint16> *voxelData) : _save(save), _voxelData(voxelData)
+{
+	// shape with index 0 is always empty
+	getShape(ShapeKey{ });
+}
+
+/**
+ * Cleans up the occupancy grid.
+ */
+VoxelOccupancy::~VoxelOccupancy()
+{
+
+}
+
+/**
+ * Gets row of LOFT for given tile part.
+ * @param part Tile part, can be null.
+ * @param layer LOFT layer.
+ * @param y Row in layer.
+ * @return Bits of the row, bit `15 - x` represent voxel `x`.
+ */
+Uint16 VoxelOccupancy::getLoftRow(const MapData* part, int layer, int y) const
+{
+	if (part)
+	{
+		const size_t idx = part->getLoftID(layer) * RowCount + y;
+		if (idx < _voxelData->size())
+		{
+			return (*_voxelData)[idx];
+		}
+	}
+	return 0;
+}
+
+/**
+ * Finds shape that match given key, if there is none then new one is created.
+ * @param key Parts of tile and grav lift flag.
+ * @return Index of shape.
+ */
+Uint32 VoxelOccupancy::getShape(const ShapeKey& key)
+{
+	auto it = _shapesIndex.find(key);
+	if (it != _shapesIndex.end())
+	{
+		return it->second;
+	}
+
+	Shape shape = { };
+	shape.gravLiftTop = key[O_MAX] != nullptr;
+	for (int i = O_FLOOR; i < O_MAX; ++i)
+	{
+		shape.parts[i] = key[i];
+	}
+	for (int layer = 0; layer < LayerCount; ++layer)
+	{
+		for (int i = O_FLOOR; i < O_MAX; ++i)
+		{
+			for (int y = 0; y < RowCount; ++y)
+			{
+				const Uint16 row = getLoftRow(shape.parts[i], layer, y);
+				if (row)
+				{
+					shape.rows[layer * RowCount + y] |= row;
+					shape.layerParts[layer] |= 1 << i;
+				}
+			}
+		}
+	}
+	if (shape.gravLiftTop)
+	{
+		for (int y = 0; y < RowCount; ++y)
+		{
+			shape.rows[y] = 0xFFFF;
+		}
+	}
+
+	const Uint32 index = (Uint32)_shapes.size();
+	_shapes.push_back(shape);
+	_shapesIndex.insert(std::make_pair(key, index));
+	return index;
+}
+
+/**
+ * Finds which part of tile occupies given voxel, use same order as `TileEngine::voxelCheck` always did.
+ * @param shape Shape of tile.
+ * @param layer LOFT layer.
+ * @param x Voxel x inside tile.
+ * @param y Voxel y inside tile.
+ * @return Tile part that was hit.
+ */
+VoxelType VoxelOccupancy::resolvePart(const Shape& shape, int layer, int x, int y) const
+{
+	if (shape.gravLiftTop && layer == 0)
+	{
+		return V_FLOOR;
+	}
+	for (int i = O_FLOOR; i < O_MAX; ++i)
+	{
+		if ((shape.layerParts[layer] & (1 << i)) && (getLoftRow(shape.parts[i], layer, y) & (1 << (15 - x))))
+		{
+			return (VoxelType)i;
+		}
+	}
+	return V_EMPTY;
+}
+
+/**
+ * Builds shapes of all tiles on map.
+ */
+void VoxelOccupancy::rebuild()
+{
+	const int size = _save->getMapSizeXYZ();
+	_tileShapes.assign(size, 0);
+	for (int i = 0; i < size; ++i)
+	{
+		update(_save->getTile(i));
+	}
+}
+
+/**
+ * Updates shape of tile, need be called each time tile part or ufo door state change.
+ * Tile above is updated too, as it depends on grav lift below it.
+ * @param tile Tile that changed.
+ */
+void VoxelOccupancy::update(Tile *tile)
+{
+	if (_tileShapes.size() != (size_t)_save->getMapSizeXYZ())
+	{
+		// map was resized, old data is useless
+		rebuild();
+		return;
+	}
+
+	for (int i = 0; i < 2 && tile; ++i, tile = _save->getAboveTile(tile))
+	{
+		const Tile *tileBelow = _save->getBelowTile(tile);
+
+		ShapeKey key = { };
+		for (int part = O_FLOOR; part < O_MAX; ++part)
+		{
+			const TilePart tp = (TilePart)part;
+			if ((tp == O_WESTWALL || tp == O_NORTHWALL) && tile->isUfoDoorOpen(tp))
+			{
+				continue;
+			}
+			key[part] = tile->getMapData(tp);
+		}
+		if (tile->hasGravLiftFloor() && !(tileBelow && tileBelow->hasGravLiftFloor()))
+		{
+			key[O_MAX] = tile->getMapData(O_FLOOR);
+		}
+
+		_tileShapes[_save->getTileIndex(tile->getPosition())] = getShape(key);
+	}
+}
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <map>
+#include <array>
+#include <SDL_types.h>
+#include "Position.h"
+#include "../Mod/MapData.h"
+
+namespace OpenXcom
+{
+
+class SavedBattleGame;
+class Tile;
+
+/**
+ * Precomputed terrain occupancy of the whole battle map in voxel space.
+ * Every tile points to a bit packed shape of its solid terrain voxels,
+ * tiles with same parts (and same door state) share one shape.
+ * Testing terrain in any voxel is one index lookup and one bit test,
+ * part type is resolved only when bit is set.
+ */
+class VoxelOccupancy
+{
+public:
+	/// Number of LOFT layers in one tile, each is two voxels high.
+	static constexpr int LayerCount = Position::TileZ / 2;
+	/// Number of voxel rows in one LOFT layer.
+	static constexpr int RowCount = Position::TileXY;
+
+private:
+	/**
+	 * Helper struct storing voxels of one tile terrain.
+	 */
+	struct Shape
+	{
+		/// Union of all parts, indexed by `layer * RowCount + y`, bit `15 - x`.
+		Uint16 rows[LayerCount * RowCount];
+		/// Side channel with mask of parts that have any voxel in given layer.
+		Uint8 layerParts[LayerCount];
+		/// Parts used to build this shape, open ufo doors are skipped.
+		const MapData* parts[O_MAX];
+		/// Lowest layer is solid floor of grav lift.
+		bool gravLiftTop;
+	};
+	/// Key used to find already existing shape.
+	using ShapeKey = std::array<const MapData*, O_MAX + 1>;
+
+	SavedBattleGame *_save;
+	const std::vector<Uint16> *_voxelData;
+	std::vector<Uint32> _tileShapes;
+	std::vector<Shape> _shapes;
+	std::map<ShapeKey, Uint32> _shapesIndex;
+
+	/// Gets row of LOFT for given part and layer.
+	Uint16 getLoftRow(const MapData* part, int layer, int y) const;
+	/// Find or create shape for given key.
+	Uint32 getShape(const ShapeKey& key);
+	/// Finds which part of shape was hit by voxel.
+	VoxelType resolvePart(const Shape& shape, int layer, int x, int y) const;
+
+public:
+	/// Creates empty occupancy grid.
+	VoxelOccupancy(SavedBattleGame *save, const std::vector<Uint16> *voxelData);
+	/// Cleans up the occupancy grid.
+	~VoxelOccupancy();
+
+	/// Builds data for whole map.
+	void rebuild();
+	/// Updates data of one tile after its terrain changed.
+	void update(Tile *tile);
+
+	/**
+	 * Checks what terrain part occupies given voxel.
+	 * @param voxel Voxel to check, need be inside tile of `tileIndex`.
+	 * @param tileIndex Index of tile where voxel is.
+	 * @return Part hit or V_EMPTY.
+	 */
+	VoxelType check(Position voxel, int tileIndex) const
+	{
+		const Shape& shape = _shapes[_tileShapes[tileIndex]];
+		const int layer = (voxel.z % Position::TileZ) / 2;
+		const int x = voxel.x % Position::TileXY;
+		const int y = voxel.y % Position::TileXY;
+		if (shape.rows[layer * RowCount + y] & (1 << (15 - x)))
+		{
+			return resolvePart(shape, layer, x, y);
+		}
+		return V_EMPTY;
+	}
+
+	/// Gets number of distinct terrain shapes on map.
+	int getShapesCount() const { return (int)_shapes.size(); }
+};
+
+}
@@ -26,6 +26,7 @@
 #include <fstream>
 #include <string>
 #include <list>
+#include <mutex>
 #include <stdint.h>
 #include <time.h>
 #include <signal.h>
@@ -72,6 +73,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
 #include <sys/param.h>
 #include <sys/types.h>
 #include <pwd.h>
@@ -961,6 +964,45 @@ time_t getDateModified(const std::string &path)
 #endif
 }
 
+/**
+ * Gets the modification time of a file in best resolution
+ * the platform has, together with its size. Together they
+ * tell if file was changed, even twice in one second.
+ * @param path Full path to file.
+ * @param mtime Modification time, in platform specific units.
+ * @param size Size of file in bytes.
+ * @return False if the file doesn't exist.
+ */
+bool getFileStamp(const std::string &path, Uint64 &mtime, Uint64 &size)
+{
+#ifdef _WIN32
+	auto pathW = pathToWindows(path);
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExW(pathW.c_str(), GetFileExInfoStandard, &data))
+	{
+		return false;
+	}
+	mtime = ((Uint64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	size = ((Uint64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+	return true;
+#else
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+	{
+		return false;
+	}
+#if defined(__APPLE__)
+	mtime = (Uint64)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+	mtime = (Uint64)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#else
+	mtime = (Uint64)info.st_mtime * 1000000000;
+#endif
+	size = (Uint64)info.st_size;
+	return true;
+#endif
+}
+
 /**
  * Converts a date/time into a human-readable string
  * using the ISO 8601 standard.
@@ -1006,9 +1048,12 @@ bool moveFile(const std::string &src, const std::string &dest)
 	auto dstW = pathToWindows(dest);
 	return (MoveFileExW(srcW.c_str(), dstW.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
 #else
-	// TODO In fact all remaining uses of this are renaming files inside a single directory
-	// so we may as well uncomment the rename() and drop the rest.
-	//return (rename(src.c_str(), dest.c_str()) == 0);
+	// all remaining uses of this are renaming files inside a single directory,
+	// rename is atomic there, copying is only fallback for other cases.
+	if (rename(src.c_str(), dest.c_str()) == 0)
+	{
+		return true;
+	}
 	std::ifstream srcStream;
 	std::ofstream destStream;
 	srcStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
@@ -1090,6 +1135,52 @@ bool writeFile(const std::string& filename, const std::vector<unsigned char>& da
 	return true;
 }
 
+/**
+ * Writes a file and waits until its content is on disk.
+ * Does not log anything, so it can be used by background threads.
+ * @param filename - where to writeFile
+ * @param data - what to writeFile
+ * @return if we did write it.
+ */
+bool writeFileSync(const std::string& filename, const std::string& data)
+{
+#ifdef _WIN32
+	auto fileW = pathToWindows(filename);
+	HANDLE file = CreateFileW(fileW.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	DWORD written = 0;
+	bool ok = WriteFile(file, data.data(), (DWORD)data.size(), &written, NULL) && written == data.size();
+	ok = FlushFileBuffers(file) && ok;
+	return CloseHandle(file) && ok;
+#else
+	int file = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (file < 0)
+	{
+		return false;
+	}
+	size_t done = 0;
+	while (done < data.size())
+	{
+		ssize_t written = ::write(file, data.data() + done, data.size() - done);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			::close(file);
+			return false;
+		}
+		done += written;
+	}
+	bool ok = fsync(file) == 0;
+	return ::close(file) == 0 && ok;
+#endif
+}
+
 /**
  * Fully reads a file and returns a stream
  * @param filename - what to readFile
@@ -1602,6 +1693,7 @@ static bool logToFile(const std::string& filename, const std::string& data) {
 static const size_t LOG_BUFFER_LIMIT = 1<<10;
 static std::list<std::pair<int, std::string>> logBuffer;
 static std::string logFileName;
+static std::mutex logMutex; // loading of saves can log from worker threads
 const std::string& getLogFileName() { return logFileName; }
 
 /**
@@ -1616,6 +1708,7 @@ void setLogFileName(const std::string& name) {
 	logFileName = name;
 }
 void log(int level, const std::ostringstream& baremsgstream) {
+	std::lock_guard<std::mutex> lock(logMutex);
 	std::ostringstream msgstream;
 	msgstream << "[" << CrossPlatform::now() << "]" << "\t"
 			  << "[" << Logger::toString(level) << "]" << "\t"
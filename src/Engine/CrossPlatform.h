@@ -72,6 +72,9 @@ public:
 	/// Size of buffer.
 	std::size_t size() const { return _size; }
 
+	/// Shrinks visible size of buffer, memory is released only with whole buffer.
+	void shrink(std::size_t size) { if (size < _size) _size = size; }
+
 	/// Data of buffer.
 	const void* data() const { return _data.get(); }
 
@@ -230,6 +233,8 @@ namespace CrossPlatform
 	bool isQuitShortcut(const SDL_Event &ev);
 	/// Gets the modified date of a file.
 	time_t getDateModified(const std::string &path);
+	/// Gets the precise modification time and size of a file.
+	bool getFileStamp(const std::string &path, Uint64 &mtime, Uint64 &size);
 	/// Converts a timestamp to a string.
 	std::pair<std::string, std::string> timeToString(time_t time);
 	/// Move/rename a file between paths.
@@ -239,6 +244,8 @@ namespace CrossPlatform
 	/// Writes out a file
 	bool writeFile(const std::string& filename, const std::string& data);
 	bool writeFile(const std::string& filename, const std::vector<unsigned char>& data);
+	/// Writes out a file and flushes it to disk, safe to call from any thread.
+	bool writeFileSync(const std::string& filename, const std::string& data);
 	/// Reads in a file
 	std::unique_ptr<std::istream> readFile(const std::string& filename);
 	/// Reads in a file
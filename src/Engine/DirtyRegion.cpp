@@ -0,0 +1,160 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DirtyRegion.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Gets smallest area that contains both areas.
+ */
+GraphSubset unionArea(const GraphSubset& a, const GraphSubset& b)
+{
+	return GraphSubset(
+		std::make_pair(std::min(a.beg_x, b.beg_x), std::max(a.end_x, b.end_x)),
+		std::make_pair(std::min(a.beg_y, b.beg_y), std::max(a.end_y, b.end_y))
+	);
+}
+
+}
+
+/**
+ * Creates empty region.
+ */
+DirtyRegion::DirtyRegion()
+{
+
+}
+
+/**
+ * Cleans up the region.
+ */
+DirtyRegion::~DirtyRegion()
+{
+
+}
+
+/**
+ * Adds area to region, all areas it overlaps are merged with it into one.
+ * @param area Area of surface.
+ */
+void DirtyRegion::add(GraphSubset area)
+{
+	if (_full || !area)
+	{
+		return;
+	}
+
+	bool merged;
+	do
+	{
+		merged = false;
+		for (size_t i = 0; i < _areas.size(); ++i)
+		{
+			if (GraphSubset::intersection(_areas[i], area))
+			{
+				area = unionArea(area, _areas[i]);
+				_areas[i] = _areas.back();
+				_areas.pop_back();
+				merged = true;
+				break;
+			}
+		}
+	}
+	while (merged);
+
+	if ((int)_areas.size() >= AreasMax)
+	{
+		_full = true;
+		return;
+	}
+	_bounds = _areas.empty() ? area : unionArea(_bounds, area);
+	_areas.push_back(area);
+}
+
+/**
+ * Adds all areas of other region.
+ * @param other Other region.
+ */
+void DirtyRegion::add(const DirtyRegion& other)
+{
+	if (other._full)
+	{
+		_full = true;
+		return;
+	}
+	for (const auto& area : other._areas)
+	{
+		add(area);
+	}
+}
+
+/**
+ * Removes all areas.
+ */
+void DirtyRegion::clear()
+{
+	_areas.clear();
+	_bounds = GraphSubset();
+	_full = false;
+}
+
+/**
+ * Checks if area overlaps any area of region.
+ * @param area Area of surface.
+ * @return True if area need be drawn.
+ */
+bool DirtyRegion::intersects(const GraphSubset& area) const
+{
+	if (_full)
+	{
+		return true;
+	}
+	if (_areas.empty() || !GraphSubset::intersection(_bounds, area))
+	{
+		return false;
+	}
+	for (const auto& a : _areas)
+	{
+		if (GraphSubset::intersection(a, area))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Gets sum of sizes of all areas, areas never overlap.
+ * @return Number of pixels.
+ */
+int DirtyRegion::getSize() const
+{
+	int size = 0;
+	for (const auto& a : _areas)
+	{
+		size += a.size_x() * a.size_y();
+	}
+	return size;
+}
+
+}
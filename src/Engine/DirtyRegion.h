@@ -0,0 +1,68 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "GraphSubset.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Set of areas of surface that need be drawn again.
+ * Overlapping areas are merged, when too many of them are added whole surface is marked instead.
+ */
+class DirtyRegion
+{
+public:
+	/// Max number of separate areas.
+	static constexpr int AreasMax = 128;
+
+private:
+	std::vector<GraphSubset> _areas;
+	GraphSubset _bounds;
+	bool _full = false;
+
+public:
+	/// Creates empty region.
+	DirtyRegion();
+	/// Cleans up the region.
+	~DirtyRegion();
+
+	/// Adds area to region.
+	void add(GraphSubset area);
+	/// Adds all areas of other region.
+	void add(const DirtyRegion& other);
+	/// Marks whole surface.
+	void setFull() { _full = true; }
+	/// Removes all areas.
+	void clear();
+
+	/// Checks if region cover whole surface.
+	bool isFull() const { return _full; }
+	/// Checks if there is nothing in region.
+	bool empty() const { return !_full && _areas.empty(); }
+	/// Checks if area overlaps any area of region.
+	bool intersects(const GraphSubset& area) const;
+	/// Gets sum of sizes of all areas.
+	int getSize() const;
+	/// Gets all areas.
+	const std::vector<GraphSubset>& getAreas() const { return _areas; }
+};
+
+}
@@ -33,6 +33,7 @@
 #include "../Mod/Mod.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SaveSnapshot.h"
 #include "Action.h"
 #include "Exception.h"
 #include "Options.h"
@@ -41,7 +42,9 @@
 #include "Unicode.h"
 #include "../Ufopaedia/UfopaediaStartState.h"
 #include "../Menu/NotesState.h"
+#include "../Menu/SaveGameState.h"
 #include "../Geoscape/GeoscapeState.h"
+#include "../Battlescape/BattlescapeState.h"
 #include "../Menu/TestState.h"
 #include <algorithm>
 #include "../fallthrough.h"
@@ -116,6 +119,10 @@ Game::~Game()
 	Sound::stop();
 	Music::stop();
 
+	// don't leave half written save behind
+	SaveSnapshot::waitBackground();
+	SaveGameState::reportBackgroundSaves(nullptr);
+
 	for (auto* state : _states)
 	{
 		delete state;
@@ -160,6 +167,9 @@ void Game::run()
 			_deleted.pop_back();
 		}
 
+		// Show results of saves written in background
+		SaveGameState::reportBackgroundSaves(_states.back()->getPalette());
+
 		// Initialize active state
 		if (!_init)
 		{
@@ -381,7 +391,11 @@ void Game::run()
 		}
 	}
 
-	Options::save();
+	// benchmark changes options only for itself
+	if (Options::getBenchmarkTurns() == 0)
+	{
+		Options::save();
+	}
 }
 
 /**
@@ -581,6 +595,23 @@ GeoscapeState* Game::getGeoscapeState() const
 	return nullptr;
 }
 
+/**
+ * Returns the BattlescapeState from the background (if available).
+ * @return Pointer to BattlescapeState, or nullptr if not available.
+ */
+BattlescapeState* Game::getBattlescapeState() const
+{
+	for (auto* state : _states)
+	{
+		auto* battlescape = dynamic_cast<BattlescapeState*>(state);
+		if (battlescape)
+		{
+			return battlescape;
+		}
+	}
+	return nullptr;
+}
+
 /**
  * Checks if the game is currently quitting.
  * @return whether the game is shutting down or not.
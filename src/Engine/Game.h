@@ -34,6 +34,7 @@ class ModInfo;
 class FpsCounter;
 class Action;
 class GeoscapeState;
+class BattlescapeState;
 
 /**
  * The core of the game engine, manages the game's entire contents and structure.
@@ -105,6 +106,8 @@ public:
 	bool containsNotesState() const;
 	/// Returns the GeoscapeState from the background (if available).
 	GeoscapeState* getGeoscapeState() const;
+	/// Returns the BattlescapeState from the background (if available).
+	BattlescapeState* getBattlescapeState() const;
 	/// Returns whether the game is shutting down.
 	bool isQuitting() const;
 	/// Loads the default and current language.
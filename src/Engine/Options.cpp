@@ -27,6 +27,7 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
 #include "../Engine/Yaml.h"
 #include "Exception.h"
 #include "Logger.h"
@@ -57,6 +58,11 @@ int _passwordCheck = -1;
 bool _loadLastSave = false;
 std::string _loadThisSave = "";
 bool _loadLastSaveExpended = false;
+int _benchmarkTurns = 0;
+Uint64 _benchmarkSeed = 0;
+bool _benchmarkHasSeed = false;
+std::string _hitChancesFile = "";
+int _hitChancesShots = 20000;
 
 /**
  * Sets up the options by creating their OptionInfo metadata.
@@ -112,6 +118,7 @@ void createOptionsOXC()
 	_info.push_back(OptionInfo(OPTION_OXC, "maxFrameSkip", &maxFrameSkip, 0));
 #endif
 	_info.push_back(OptionInfo(OPTION_OXC, "traceAI", &traceAI, false));
+	_info.push_back(OptionInfo(OPTION_OXC, "aiThreads", &aiThreads, 0));
 	_info.push_back(OptionInfo(OPTION_OXC, "verboseLogging", &verboseLogging, false));
 	_info.push_back(OptionInfo(OPTION_OXC, "StereoSound", &StereoSound, true));
 	//_info.push_back(OptionInfo(OPTION_OXC, "baseXResolution", &baseXResolution, Screen::ORIGINAL_WIDTH));
@@ -364,6 +371,7 @@ void createOptionsOXCE()
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceThumbButtons", &oxceThumbButtons, true));
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceThrottleMouseMoveEvent", &oxceThrottleMouseMoveEvent, 0));
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceDisableThinkingProgressBar", &oxceDisableThinkingProgressBar, false));
+	_info.push_back(OptionInfo(OPTION_OXCE, "oxceSaveJournal", &oxceSaveJournal, 0));
 
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceEmbeddedOnly", &oxceEmbeddedOnly, true));
 	_info.push_back(OptionInfo(OPTION_OXCE, "oxceListVFSContents", &oxceListVFSContents, false));
@@ -752,6 +760,23 @@ static void loadArgs()
 					_loadLastSave = true;
 					_loadThisSave = argv[i];
 				}
+				else if (argname == "benchmark")
+				{
+					_benchmarkTurns = std::max(0, atoi(argv[i].c_str()));
+				}
+				else if (argname == "seed")
+				{
+					_benchmarkSeed = strtoull(argv[i].c_str(), nullptr, 10);
+					_benchmarkHasSeed = true;
+				}
+				else if (argname == "hitchances")
+				{
+					_hitChancesFile = argv[i];
+				}
+				else if (argname == "shots")
+				{
+					_hitChancesShots = std::max(1, atoi(argv[i].c_str()));
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -790,6 +815,14 @@ static bool showHelp()
 	help << "        load last save" << std::endl << std::endl;
 	help << "-load FILENAME" << std::endl;
 	help << "        load the specified FILENAME (from the corresponding master mod subfolder)" << std::endl << std::endl;
+	help << "-benchmark TURNS" << std::endl;
+	help << "        without window, play TURNS turns of battle loaded by -load with AI on both sides and report time of each phase" << std::endl << std::endl;
+	help << "-seed SEED" << std::endl;
+	help << "        use SEED for random numbers of -benchmark instead of one stored in save, or for -hitChances" << std::endl << std::endl;
+	help << "-hitChances FILENAME" << std::endl;
+	help << "        without window, simulate shots of every accuracy and distance and write hitChancesTable ruleset to FILENAME" << std::endl << std::endl;
+	help << "-shots SHOTS" << std::endl;
+	help << "        number of shots simulated by -hitChances for each value of table (default 20000)" << std::endl << std::endl;
 	help << "-version" << std::endl;
 	help << "        show version number" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -1202,6 +1235,27 @@ void expendLoadLastSave()
 	_loadLastSaveExpended = true;
 }
 
+int getBenchmarkTurns()
+{
+	return _benchmarkTurns;
+}
+
+bool getBenchmarkSeed(Uint64& seed)
+{
+	seed = _benchmarkSeed;
+	return _benchmarkHasSeed;
+}
+
+const std::string& getHitChancesFile()
+{
+	return _hitChancesFile;
+}
+
+int getHitChancesShots()
+{
+	return _hitChancesShots;
+}
+
 /**
  * Sets up the game's Data folder where the data files
  * are loaded from and the User folder and Config
@@ -135,6 +135,14 @@ namespace Options
 	const std::string& getLoadThisSave();
 	/// And do it only at startup
 	void expendLoadLastSave();
+	/// Gets number of turns to play in benchmark mode, zero when not benchmarking.
+	int getBenchmarkTurns();
+	/// Gets seed for benchmark, false if none was given.
+	bool getBenchmarkSeed(Uint64& seed);
+	/// Gets file where generated hit chances should be written, empty when not generating.
+	const std::string& getHitChancesFile();
+	/// Gets number of shots simulated for each hit chance.
+	int getHitChancesShots();
 }
 
 }
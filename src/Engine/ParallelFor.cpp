@@ -0,0 +1,141 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <SDL_thread.h>
+#include "ParallelFor.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Upper limit of threads, more do not help with sizes of our jobs.
+const int MaxThreads = 64;
+
+/**
+ * Part of range processed by one thread.
+ */
+struct ParallelForChunk
+{
+	const std::function<void(int begin, int end)>* func;
+	int begin;
+	int end;
+	std::exception_ptr error;
+};
+
+/**
+ * Entry point of worker thread.
+ * Exception is caught and stored in chunk, escaping worker thread would terminate the game.
+ * @param data Pointer to ParallelForChunk.
+ * @return Always zero.
+ */
+int SDLCALL runChunk(void* data)
+{
+	auto* chunk = (ParallelForChunk*)data;
+	try
+	{
+		(*chunk->func)(chunk->begin, chunk->end);
+	}
+	catch (...)
+	{
+		chunk->error = std::current_exception();
+	}
+	return 0;
+}
+
+}
+
+/**
+ * Gets number of threads to use for parallel work.
+ * @param wanted Number requested by user, zero or less means all cores.
+ * @return Number of threads, at least one.
+ */
+int getWorkerThreadsCount(int wanted)
+{
+	if (wanted <= 0)
+	{
+		wanted = (int)std::thread::hardware_concurrency();
+	}
+	return std::max(1, std::min(wanted, MaxThreads));
+}
+
+/**
+ * Splits range of indexes into continuous chunks and process each one in separate thread.
+ * Calling thread process first chunk itself and waits for the others.
+ * If no thread can be created, all work is done by calling thread.
+ * `func` must not change any state shared with other chunks.
+ * Exception thrown by `func` is rethrown by calling thread after all chunks finish,
+ * if more chunks throw, exception of the first one is rethrown.
+ * @param count Size of range, indexes go from 0 to count - 1.
+ * @param threads Maximum number of threads to use, including calling one.
+ * @param minChunk Smallest number of indexes worth to move to other thread.
+ * @param func Function that process range from begin to end (exclusive).
+ */
+void parallelFor(int count, int threads, int minChunk, const std::function<void(int begin, int end)>& func)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+	const int chunksCount = std::max(1, std::min(threads, count / std::max(1, minChunk)));
+	if (chunksCount == 1)
+	{
+		func(0, count);
+		return;
+	}
+
+	std::vector<ParallelForChunk> chunks(chunksCount);
+	std::vector<SDL_Thread*> workers(chunksCount, nullptr);
+	for (int i = 0; i < chunksCount; ++i)
+	{
+		chunks[i].func = &func;
+		chunks[i].begin = (int)((long long)count * i / chunksCount);
+		chunks[i].end = (int)((long long)count * (i + 1) / chunksCount);
+	}
+	for (int i = 1; i < chunksCount; ++i)
+	{
+		workers[i] = SDL_CreateThread(runChunk, &chunks[i]);
+	}
+
+	runChunk(&chunks[0]);
+	for (int i = 1; i < chunksCount; ++i)
+	{
+		if (workers[i])
+		{
+			SDL_WaitThread(workers[i], nullptr);
+		}
+		else
+		{
+			// If we can't create the thread, just do it here
+			runChunk(&chunks[i]);
+		}
+	}
+	for (const auto& chunk : chunks)
+	{
+		if (chunk.error)
+		{
+			std::rethrow_exception(chunk.error);
+		}
+	}
+}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <functional>
+#include <exception>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/// Gets number of threads to use for parallel work, zero or less means all cores.
+int getWorkerThreadsCount(int wanted);
+/// Splits range of indexes between worker threads and waits until all of them finish.
+void parallelFor(int count, int threads, int minChunk, const std::function<void(int begin, int end)>& func);
+
+/**
+ * Creates one object for each index on worker threads and appends them to list in order of indexes, so result do not depend on number of threads.
+ * Null objects are skipped. Exception thrown by `create` is caught by worker,
+ * all successfully created objects are still appended and then first exception is rethrown by calling thread.
+ * @param count Number of indexes, they go from 0 to count - 1.
+ * @param threads Maximum number of threads to use, including calling one.
+ * @param minChunk Smallest number of indexes worth to move to other thread.
+ * @param output List where created objects are appended.
+ * @param create Function that creates object for given index, it must not change any state shared with other indexes.
+ */
+template<typename T, typename Func>
+void parallelAppend(int count, int threads, int minChunk, std::vector<T*>& output, Func create)
+{
+	std::vector<T*> created(count > 0 ? count : 0, nullptr);
+	std::vector<std::exception_ptr> errors(created.size());
+	parallelFor(count, threads, minChunk,
+		[&](int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				try
+				{
+					created[i] = create(i);
+				}
+				catch (...)
+				{
+					errors[i] = std::current_exception();
+				}
+			}
+		}
+	);
+	for (T* obj : created)
+	{
+		if (obj)
+		{
+			output.push_back(obj);
+		}
+	}
+	for (const auto& error : errors)
+	{
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PhaseTimer.h"
+
+namespace OpenXcom
+{
+
+bool PhaseTimer::_enabled = false;
+Uint64 PhaseTimer::_nanoseconds[TP_MAX] = { };
+Uint64 PhaseTimer::_calls[TP_MAX] = { };
+int PhaseTimer::_depth[TP_MAX] = { };
+Uint64 PhaseTimer::_cacheHits[CC_MAX] = { };
+Uint64 PhaseTimer::_cacheMisses[CC_MAX] = { };
+
+/**
+ * Clears all accumulated times and cache statistics, scopes that are open stay open.
+ */
+void PhaseTimer::reset()
+{
+	for (int i = 0; i < TP_MAX; ++i)
+	{
+		_nanoseconds[i] = 0;
+		_calls[i] = 0;
+	}
+	for (int i = 0; i < CC_MAX; ++i)
+	{
+		_cacheHits[i] = 0;
+		_cacheMisses[i] = 0;
+	}
+}
+
+/**
+ * Gets name of phase used in reports.
+ * @param phase Phase.
+ * @return Name.
+ */
+const char* PhaseTimer::getName(TimedPhase phase)
+{
+	switch (phase)
+	{
+	case TP_AI: return "AI total";
+	case TP_PATHFINDING: return "pathfinding";
+	case TP_EXPOSURE: return "LOS/exposure";
+	case TP_REACTION: return "reaction fire";
+	case TP_FOV: return "FOV";
+	default: return "unknown";
+	}
+}
+
+/**
+ * Gets name of cache used in reports.
+ * @param cache Cache.
+ * @return Name.
+ */
+const char* PhaseTimer::getCacheName(CountedCache cache)
+{
+	switch (cache)
+	{
+	case CC_VISIBILITY: return "visibility memo";
+	case CC_REACHABILITY: return "reachability";
+	case CC_LIGHT: return "light sources";
+	default: return "unknown";
+	}
+}
+
+}
@@ -0,0 +1,133 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Parts of battle logic that are timed separately.
+ */
+enum TimedPhase
+{
+	TP_AI,
+	TP_PATHFINDING,
+	TP_EXPOSURE,
+	TP_REACTION,
+	TP_FOV,
+	TP_MAX
+};
+
+/**
+ * Caches of battle logic whose hits are counted.
+ */
+enum CountedCache
+{
+	CC_VISIBILITY,
+	CC_REACHABILITY,
+	CC_LIGHT,
+	CC_MAX
+};
+
+/**
+ * Accumulates wall time spent in each phase of battle logic.
+ * Disabled by default, then every scope cost one check of flag.
+ * Only outermost scope of each phase is counted, phases can overlap (pathfinding inside of AI).
+ * Only main thread is allowed to time phases.
+ */
+class PhaseTimer
+{
+	static bool _enabled;
+	static Uint64 _nanoseconds[TP_MAX];
+	static Uint64 _calls[TP_MAX];
+	static int _depth[TP_MAX];
+	static Uint64 _cacheHits[CC_MAX];
+	static Uint64 _cacheMisses[CC_MAX];
+
+public:
+	/// Enables or disables timing.
+	static void setEnabled(bool enabled) { _enabled = enabled; }
+	/// Is timing enabled?
+	static bool isEnabled() { return _enabled; }
+	/// Clears all accumulated times.
+	static void reset();
+	/// Gets name of phase.
+	static const char* getName(TimedPhase phase);
+	/// Gets total time spent in phase.
+	static double getMilliseconds(TimedPhase phase) { return _nanoseconds[phase] / 1000000.0; }
+	/// Gets number of times phase was entered.
+	static Uint64 getCalls(TimedPhase phase) { return _calls[phase]; }
+
+	/// Adds hits and misses of cache, ignored when timing is disabled.
+	static void addCacheStats(CountedCache cache, Uint64 hits, Uint64 misses)
+	{
+		if (_enabled)
+		{
+			_cacheHits[cache] += hits;
+			_cacheMisses[cache] += misses;
+		}
+	}
+	/// Gets name of cache.
+	static const char* getCacheName(CountedCache cache);
+	/// Gets number of cache hits.
+	static Uint64 getCacheHits(CountedCache cache) { return _cacheHits[cache]; }
+	/// Gets number of cache misses.
+	static Uint64 getCacheMisses(CountedCache cache) { return _cacheMisses[cache]; }
+
+	/**
+	 * Scope guard that adds its lifetime to phase.
+	 */
+	class Scope
+	{
+		std::chrono::steady_clock::time_point _start;
+		TimedPhase _phase;
+		bool _counted;
+		bool _active;
+
+	public:
+		/// Starts timing of phase.
+		Scope(TimedPhase phase) : _phase(phase), _counted(_enabled), _active(false)
+		{
+			if (_counted && _depth[phase]++ == 0)
+			{
+				_active = true;
+				_start = std::chrono::steady_clock::now();
+			}
+		}
+		/// Stops timing of phase.
+		~Scope()
+		{
+			if (_active)
+			{
+				_nanoseconds[_phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+				_calls[_phase] += 1;
+			}
+			if (_counted)
+			{
+				--_depth[_phase];
+			}
+		}
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+};
+
+}
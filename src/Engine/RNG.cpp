@@ -101,8 +101,9 @@ RandomState x;
 
 /**
  * Separate state for some auxiliary random numbers that do not affect game state. Do not use during other variable static initialization because: https://isocpp.org/wiki/faq/ctors#static-init-order-on-first-use-members
+ * Every thread has its own copy, objects created by worker threads (e.g. soldiers when loading save) use it too.
  */
-RandomState x_seedless;
+thread_local RandomState x_seedless;
 
 
 
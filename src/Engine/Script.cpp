@@ -501,6 +501,41 @@ static inline void scriptExe(ScriptWorkerBase& data, const Uint8* proc)
 //						Script class
 ////////////////////////////////////////////////////////////
 
+/**
+ * Runs events before script, script and events after it for one pixel.
+ * Each of them starts from input values, not from output of previous one.
+ * @param arg Input and output values of pixel.
+ */
+void ScriptWorkerBlit::runScripts(Output& arg)
+{
+	set(arg);
+	if (auto ptr = _events)
+	{
+		while (*ptr)
+		{
+			reset(arg);
+			scriptExe(*this, ptr->data());
+			++ptr;
+		}
+		++ptr;
+
+		reset(arg);
+		scriptExe(*this, _proc);
+
+		while (*ptr)
+		{
+			reset(arg);
+			scriptExe(*this, ptr->data());
+			++ptr;
+		}
+	}
+	else
+	{
+		scriptExe(*this, _proc);
+	}
+	get(arg);
+}
+
 void ScriptWorkerBlit::executeBlit(const Surface* src, Surface* dest, int x, int y, int shade)
 {
 	executeBlit(src, dest, x, y, shade, GraphSubset{ dest->getWidth(), dest->getHeight() } );
@@ -519,63 +554,45 @@ void ScriptWorkerBlit::executeBlit(const Surface* src, Surface* dest, int x, int
 
 	destShader.setDomain(mask);
 
-	if (_proc)
+	if (_proc && _pure)
 	{
-		if (_events)
-		{
-			ShaderDrawFunc(
-				[&](Uint8& destStuff, const Uint8& srcStuff)
+		// result depends only on source pixel, each palette index is calculated once and then reused
+		int lut[256];
+		bool lutDone[256] = { };
+		ShaderDrawFunc(
+			[&](Uint8& destStuff, const Uint8& srcStuff)
+			{
+				if (srcStuff)
 				{
-					if (srcStuff)
+					if (!lutDone[srcStuff])
 					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						auto ptr = _events;
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
-						++ptr;
-
-						reset(arg);
-						scriptExe(*this, _proc);
-
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
-						++ptr;
-
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
+						ScriptWorkerBlit::Output arg = { srcStuff, 0 };
+						runScripts(arg);
+						lut[srcStuff] = arg.getFirst();
+						lutDone[srcStuff] = true;
 					}
-				},
-				destShader,
-				srcShader
-			);
-		}
-		else
-		{
-			ShaderDrawFunc(
-				[&](Uint8& destStuff, const Uint8& srcStuff)
+					if (lut[srcStuff]) destStuff = lut[srcStuff];
+				}
+			},
+			destShader,
+			srcShader
+		);
+	}
+	else if (_proc)
+	{
+		ShaderDrawFunc(
+			[&](Uint8& destStuff, const Uint8& srcStuff)
+			{
+				if (srcStuff)
 				{
-					if (srcStuff)
-					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						scriptExe(*this, _proc);
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
-					}
-				},
-				destShader,
-				srcShader
-			);
-		}
+					ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
+					runScripts(arg);
+					if (arg.getFirst()) destStuff = arg.getFirst();
+				}
+			},
+			destShader,
+			srcShader
+		);
 	}
 	else
 	{
@@ -2612,6 +2629,7 @@ bool parseDebugLog(const ScriptProcData& spd, ParserWriter& ph, const ScriptRefD
 		return true;
 	}
 
+	ph.markSideEffects();
 	for (auto i = begin; i != end; ++i)
 	{
 		const auto proc = ph.parser.getProc(ScriptRef{ "debug_impl" });
@@ -2982,6 +3000,17 @@ ScriptRefData ParserWriter::getReferece(const ScriptRef& s) const
 	if (ptr == nullptr)
 	{
 		ptr = parser.getRef(s);
+		if (ptr != nullptr)
+		{
+			// remember which outputs script reads, this decides if result can be memorized
+			for (Uint8 i = 0; i < parser.getParamSize(); ++i)
+			{
+				if (ptr == parser.getParamData(i))
+				{
+					container._outputRead |= 1 << i;
+				}
+			}
+		}
 	}
 	if (ptr == nullptr)
 	{
@@ -2994,6 +3023,14 @@ ScriptRefData ParserWriter::getReferece(const ScriptRef& s) const
 	return *ptr;
 }
 
+/**
+ * Mark that script have effects other than its outputs, its result can't be memorized.
+ */
+void ParserWriter::markSideEffects()
+{
+	container._sideEffects = true;
+}
+
 /**
  * Get current position in proc vector.
  * @return Position in proc vector.
@@ -392,6 +392,8 @@ class ScriptContainerBase
 {
 	friend struct ParserWriter;
 	std::vector<Uint8> _proc;
+	Uint16 _outputRead = 0;
+	bool _sideEffects = false;
 
 public:
 	/// Constructor.
@@ -420,6 +422,12 @@ public:
 	{
 		return *this ? _proc.data() : nullptr;
 	}
+
+	/// Test if result of script depends only on first output and on input arguments.
+	bool isPure() const
+	{
+		return (_outputRead & ~1) == 0 && !_sideEffects;
+	}
 };
 
 /**
@@ -467,6 +475,32 @@ public:
 	{
 		return _events;
 	}
+
+	/// Test if result of script and all its events depends only on first output and on input arguments.
+	bool isPure() const
+	{
+		if (!_current.isPure())
+		{
+			return false;
+		}
+		if (auto ptr = _events)
+		{
+			// two lists of events, before and after script, each ended by empty one
+			for (int i = 0; i < 2; ++i)
+			{
+				while (*ptr)
+				{
+					if (!ptr->isPure())
+					{
+						return false;
+					}
+					++ptr;
+				}
+				++ptr;
+			}
+		}
+		return true;
+	}
 };
 
 /**
@@ -822,13 +856,20 @@ class ScriptWorkerBlit : public ScriptWorkerBase
 	/// Current script set in worker.
 	const Uint8* _proc;
 	const ScriptContainerBase* _events;
+	bool _pure;
 
 public:
 	/// Type of output value from script.
 	using Output = ScriptOutputArgs<int&, int>;
 
+private:
+	/// Run events and script for one pixel.
+	void runScripts(Output& arg);
+
+public:
+
 	/// Default constructor.
-	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr)
+	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr), _pure(false)
 	{
 
 	}
@@ -843,6 +884,7 @@ public:
 		{
 			_proc = c.data();
 			_events = nullptr;
+			_pure = c.isPure();
 			updateBase<Output>(args...);
 		}
 	}
@@ -857,10 +899,16 @@ public:
 		{
 			_proc = c.data();
 			_events = c.dataEvents();
+			_pure = c.isPure();
 			updateBase<Output>(args...);
 		}
 	}
 
+	/// Test if any script is set in worker.
+	bool hasScript() const { return _proc != nullptr; }
+	/// Test if result of blit do not depend on pixels already in destination surface.
+	bool isDestIndependent() const { return !_proc || _pure; }
+
 	/// Programmable blitting using script.
 	void executeBlit(const Surface* src, Surface* dest, int x, int y, int shade);
 	/// Programmable blitting using script.
@@ -871,6 +919,7 @@ public:
 	{
 		_proc = nullptr;
 		_events = nullptr;
+		_pure = false;
 	}
 };
 
@@ -174,6 +174,8 @@ struct ParserWriter
 
 	/// Get reference based on name.
 	ScriptRefData getReferece(const ScriptRef& s) const;
+	/// Mark that script have effects other than its outputs.
+	void markSideEffects();
 
 	/// Get current position in proc vector.
 	ProgPos getCurrPos() const;
@@ -320,6 +320,44 @@ std::string YamlNodeReader::getValTag() const
 	return std::string(valTag.str, valTag.len);
 }
 
+static void hashNode(const ryml::ConstNodeRef& node, Uint64& hash)
+{
+	// fixed 64-bit hash (not `std::hash`), `size_t` is only 32 bits wide on some platforms
+	auto mix = [&hash](Uint64 value)
+	{
+		hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+	};
+	auto hashScalar = [](ryml::csubstr scalar)
+	{
+		// FNV-1a
+		Uint64 h = 0xCBF29CE484222325ull;
+		for (size_t i = 0; i < scalar.len; ++i)
+		{
+			h ^= (Uint8)scalar.str[i];
+			h *= 0x100000001B3ull;
+		}
+		return h;
+	};
+
+	mix(node.is_map() ? 1 : node.is_seq() ? 2 : 3);
+	if (node.has_key())
+		mix(hashScalar(node.key()));
+	if (node.has_val())
+		mix(hashScalar(node.val()));
+	for (const ryml::ConstNodeRef child : node.cchildren())
+		hashNode(child, hash);
+	// end of children, so moving node between levels changes hash
+	mix(4);
+}
+
+Uint64 YamlNodeReader::hash() const
+{
+	Uint64 hash = 0;
+	if (!_node.invalid())
+		hashNode(_node, hash);
+	return hash;
+}
+
 const YamlString YamlNodeReader::emit() const
 {
 	return YamlString(ryml::emitrs_yaml<std::string>(_node));
@@ -503,6 +541,38 @@ YamlNodeWriter YamlNodeWriter::operator[](ryml::csubstr key)
 	return YamlNodeWriter(_node.append_child({ryml::KEY, key}));
 }
 
+YamlNodeWriter YamlNodeWriter::writeCopy(const YamlNodeReader& source)
+{
+	ryml::Tree* tree = _node.tree();
+	ryml::id_type copy = tree->duplicate(source._node.tree(), source._node.id(), _node.id(), tree->last_child(_node.id()));
+	return YamlNodeWriter(ryml::NodeRef(tree, copy));
+}
+
+static void copyScalarsToArena(ryml::Tree* tree, ryml::id_type node)
+{
+	auto copy = [tree](ryml::NodeScalar& scalar)
+	{
+		// growing arena relocates scalars that are already there, but never source ones
+		if (scalar.tag.len)
+			scalar.tag = tree->copy_to_arena(scalar.tag);
+		if (scalar.scalar.len)
+			scalar.scalar = tree->copy_to_arena(scalar.scalar);
+		if (scalar.anchor.len)
+			scalar.anchor = tree->copy_to_arena(scalar.anchor);
+	};
+	copy(tree->_p(node)->m_key);
+	copy(tree->_p(node)->m_val);
+	for (ryml::id_type child = tree->first_child(node); child != ryml::NONE; child = tree->next_sibling(child))
+		copyScalarsToArena(tree, child);
+}
+
+YamlNodeWriter YamlNodeWriter::writeOwnedCopy(const YamlNodeReader& source)
+{
+	YamlNodeWriter copy = writeCopy(source);
+	copyScalarsToArena(_node.tree(), copy._node.id());
+	return copy;
+}
+
 YamlNodeWriter YamlNodeWriter::writeBase64(ryml::csubstr key, char* data, size_t size)
 {
 	return YamlNodeWriter(_node.append_child({ryml::KEY, key}) << c4::fmt::base64(ryml::csubstr(data, size)));
@@ -1015,4 +1085,40 @@ static auto dummyTestRead = ([]
 	return 0;
 })();
 
+static auto dummyTestCopy = ([]
+{
+	{
+		auto reader = createRootReader("foo: 1\nbar: [1, {id: 2}]");
+		OpenXcom::YAML::YamlRootNodeWriter writer;
+		writer.setAsMap();
+		writer.writeCopy(reader["bar"]);
+		writer.writeCopy(reader["foo"]);
+
+		assert(writer.toReader()["bar"].hash() == reader["bar"].hash());
+		assert(writer.toReader()["foo"].readVal<int>() == 1);
+		assert(writer.toReader()["bar"][1]["id"].readVal<int>() == 2);
+		assert(reader["foo"].hash() != reader["bar"].hash());
+		assert(reader["bar"][0].hash() != reader["bar"][1].hash());
+	}
+
+	{
+		OpenXcom::YAML::YamlRootNodeWriter writer;
+		writer.setAsMap();
+		Uint64 hash = 0;
+		{
+			auto reader = createRootReader("foo: &a !tag 1\nbar: [1, {id: 2}]");
+			writer.writeOwnedCopy(reader["bar"]);
+			writer.writeOwnedCopy(reader["foo"]);
+			hash = reader["bar"].hash();
+		}
+
+		assert(writer.toReader()["bar"].hash() == hash);
+		assert(writer.toReader()["foo"].readVal<int>() == 1);
+		assert(writer.toReader()["foo"].getValTag() == "!tag");
+		assert(writer.toReader()["bar"][1]["id"].readVal<int>() == 2);
+	}
+
+	return 0;
+})();
+
 #endif
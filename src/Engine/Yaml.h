@@ -61,6 +61,7 @@ namespace YAML
 {
 
 class YamlRootNodeReader;
+class YamlNodeWriter;
 class YamlRootNodeWriter;
 
 
@@ -207,6 +208,9 @@ public:
 	/// Returns node's value's tag, or an empty string if there is none
 	std::string getValTag() const;
 
+	/// Returns hash of the node and its descendants, keys and values included
+	Uint64 hash() const;
+
 	/// Serializes the node and its descendants to a YamlString
 	const YamlString emit() const;
 	/// Serializes the node's descendants to a YamlString
@@ -225,6 +229,7 @@ public:
 	explicit operator bool() const;
 
 	friend YamlRootNodeReader;
+	friend YamlNodeWriter;
 	friend YamlRootNodeWriter;
 };
 
@@ -303,6 +308,10 @@ public:
 	/// The callback (YamlNodeWriter w, InputType val) should specify how to write a vector element to the sequence container.
 	template <typename InputType, typename Func>
 	void write(ryml::csubstr key, const std::vector<InputType>& inputVector, Func callback);
+	/// Adds a copy of a node from any tree, with its key and descendants. Scalars are not copied, the source tree must outlive this one
+	YamlNodeWriter writeCopy(const YamlNodeReader& source);
+	/// Adds a copy of a node from any tree, with its key and descendants. Scalars are copied too, the source tree can be freed right after
+	YamlNodeWriter writeOwnedCopy(const YamlNodeReader& source);
 	/// Adds a scalar value child to the current mapping container, serializing the provided binary data
 	YamlNodeWriter writeBase64(ryml::csubstr key, char* data, size_t size);
 
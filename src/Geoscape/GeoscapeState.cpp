@@ -39,6 +39,7 @@
 #include "../Interface/ComboBox.h"
 #include "../Interface/Text.h"
 #include "../Interface/TextButton.h"
+#include "../Battlescape/WarningMessage.h"
 #include "../Engine/Timer.h"
 #include "../Savegame/GameTime.h"
 #include "../Savegame/SavedGame.h"
@@ -199,6 +200,8 @@ GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomO
 	int trainingIndicatorOffset = _game->getMod()->getInterface("geoscape")->getElement("trainingIndicator")->custom;
 	_txtTraining = new Text(59, 17, screenWidth - 61, screenHeight / 2 + 100 + trainingIndicatorOffset);
 
+	_warning = new WarningMessage(224, 24, (screenWidth - 64) / 2 - 112, screenHeight / 2 + 64);
+
 	_timeSpeed = _btn5Secs;
 	_gameTimer = new Timer(Options::geoClockSpeed);
 
@@ -257,6 +260,7 @@ GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomO
 	add(_txtYear, "text", "geoscape");
 	add(_txtSlacking, "slackingIndicator", "geoscape");
 	add(_txtTraining, "trainingIndicator", "geoscape");
+	add(_warning);
 
 	add(_txtDebug, "text", "geoscape");
 	add(_cbxRegion, "button", "geoscape");
@@ -414,6 +418,9 @@ GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomO
 	_txtSlacking->setAlign(ALIGN_RIGHT);
 	_txtTraining->setAlign(ALIGN_RIGHT);
 
+	_warning->setColor(_game->getMod()->getInterface("geoscape")->getElement("warning")->color2);
+	_warning->setTextColor(_game->getMod()->getInterface("geoscape")->getElement("warning")->color);
+
 	if (Options::showFundsOnGeoscape)
 	{
 		_txtHour->setY(_txtHour->getY()+6);
@@ -4914,6 +4921,8 @@ void GeoscapeState::resize(int &dX, int &dY)
 	_bg->setX((_globe->getWidth() - _bg->getWidth()) / 2);
 	_bg->setY((_globe->getHeight() - _bg->getHeight()) / 2);
 
+	_warning->setX(_globe->getWidth() / 2 - _warning->getWidth() / 2);
+
 	int height = (Options::baseYResolution - Screen::ORIGINAL_HEIGHT) / 2 + 10;
 	_sideTop->setHeight(height);
 	_sideTop->setY(_sidebar->getY() - height - 1);
@@ -4924,6 +4933,15 @@ void GeoscapeState::resize(int &dX, int &dY)
 	_sideLine->setY(0);
 	_sideLine->drawRect(0, 0, _sideLine->getWidth(), _sideLine->getHeight(), 15);
 }
+/**
+ * Shows a warning message over the globe.
+ * @param message Warning message.
+ */
+void GeoscapeState::warning(const std::string &message)
+{
+	_warning->showMessage(tr(message));
+}
+
 bool GeoscapeState::buttonsDisabled()
 {
 	return _zoomInEffectTimer->isRunning() || _zoomOutEffectTimer->isRunning();
@@ -31,6 +31,7 @@ class TextButton;
 class InteractiveSurface;
 class Text;
 class ComboBox;
+class WarningMessage;
 class Timer;
 class DogfightState;
 class Craft;
@@ -65,6 +66,7 @@ private:
 	ComboBox *_cbxRegion, *_cbxZone, *_cbxArea, *_cbxCountry;
 	Text *_txtSlacking;
 	Text *_txtTraining;
+	WarningMessage *_warning;
 	std::list<State*> _popups;
 	std::list<DogfightState*> _dogfights, _dogfightsToBeStarted;
 	std::vector<Craft*> _activeCrafts;
@@ -201,6 +203,8 @@ public:
 	void resize(int &dX, int &dY) override;
 	/// Handle alien mission generation.
 	void determineAlienMissions(bool isNewMonth = true, const RuleEvent* eventRules = nullptr);
+	/// Show warning message.
+	void warning(const std::string &message);
 private:
 	bool attemptAlienRaceEvolution(int month, AlienBase* ab) const;
 	/// Process each individual mission script command.
@@ -27,6 +27,7 @@
 #include "../Engine/Options.h"
 #include "ErrorMessageState.h"
 #include "../Savegame/SavedGame.h"
+#include "../Savegame/SaveJournal.h"
 #include "../Mod/RuleInterface.h"
 
 namespace OpenXcom
@@ -105,6 +106,11 @@ void DeleteGameState::btnYesClick(Action *)
 		else
 			_game->pushState(new ErrorMessageState(error, _palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
 	}
+	else
+	{
+		// journal is useless without its save
+		CrossPlatform::deleteFile(SaveJournal::getPath(_filename));
+	}
 }
 
 }
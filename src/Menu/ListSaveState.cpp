@@ -27,6 +27,7 @@
 #include "../Interface/TextButton.h"
 #include "../Interface/ToggleTextButton.h"
 #include "SaveGameState.h"
+#include "../Savegame/SaveJournal.h"
 
 namespace OpenXcom
 {
@@ -182,6 +183,10 @@ void ListSaveState::saveGame()
 			std::string oldPath = Options::getMasterUserFolder() + oldFilename;
 			std::string newPath = Options::getMasterUserFolder() + newFilename + ".sav";
 			CrossPlatform::moveFile(oldPath, newPath);
+			if (CrossPlatform::fileExists(SaveJournal::getPath(oldPath)))
+			{
+				CrossPlatform::moveFile(SaveJournal::getPath(oldPath), SaveJournal::getPath(newPath));
+			}
 		}
 	}
 	else
@@ -20,6 +20,7 @@
 #include <sstream>
 #include "../Engine/Logger.h"
 #include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SaveSnapshot.h"
 #include "../Engine/Game.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
@@ -30,6 +31,7 @@
 #include "../Geoscape/GeoscapeState.h"
 #include "ErrorMessageState.h"
 #include "../Battlescape/BattlescapeState.h"
+#include "../Battlescape/AIBenchmark.h"
 #include "../Mod/Mod.h"
 #include "../Engine/Sound.h"
 #include "../Engine/Unicode.h"
@@ -130,6 +132,8 @@ void LoadGameState::buildUi(SDL_Color *palette)
 void LoadGameState::init()
 {
 	State::init();
+	// quick save could be still written
+	SaveSnapshot::waitBackground();
 	if (_filename == SavedGame::QUICKSAVE && !CrossPlatform::fileExists(Options::getMasterUserFolder() + _filename))
 	{
 		_game->popState();
@@ -198,6 +202,10 @@ void LoadGameState::think()
 					// Try to reactivate the touch buttons
 					bs->toggleTouchButtons(false, true);
 				}
+				if (AIBenchmark::isActive())
+				{
+					AIBenchmark::start(_game);
+				}
 			}
 
 			// Clear the SDL event queue (i.e. ignore input from impatient users)
@@ -18,6 +18,7 @@
  */
 #include "SaveGameState.h"
 #include <sstream>
+#include <memory>
 #include "../Engine/Logger.h"
 #include "../Engine/Game.h"
 #include "../Engine/Exception.h"
@@ -29,7 +30,11 @@
 #include "../Interface/Text.h"
 #include "ErrorMessageState.h"
 #include "MainMenuState.h"
+#include "../Battlescape/BattlescapeState.h"
+#include "../Geoscape/GeoscapeState.h"
 #include "../Savegame/SavedGame.h"
+#include "../Savegame/SaveSnapshot.h"
+#include "../Engine/Language.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleInterface.h"
 
@@ -185,14 +190,15 @@ void SaveGameState::think()
 		// Save the game
 		try
 		{
-			std::string backup = _filename + ".bak";
-			_game->getSavedGame()->save(backup, _game->getMod());
-			std::string fullPath = Options::getMasterUserFolder() + _filename;
-			std::string bakPath = Options::getMasterUserFolder() + backup;
-			if (!CrossPlatform::moveFile(bakPath, fullPath))
+			// only copying game state need stop the game, writing is done in background
+			std::unique_ptr<SaveSnapshot> snapshot(new SaveSnapshot());
+			_game->getSavedGame()->save(*snapshot, _game->getMod());
+			if (!_game->getSavedGame()->getSavedBattle())
 			{
-				throw Exception("Save backed up in " + backup);
+				// geoscape saves can be written as journal of last full save
+				snapshot->setMaxJournals(Options::oxceSaveJournal);
 			}
+			SaveSnapshot::writeInBackground(snapshot.release(), _filename);
 
 			if (_type == SAVE_IRONMAN_END)
 			{
@@ -221,6 +227,43 @@ void SaveGameState::think()
 	}
 }
 
+/**
+ * Reports results of saves finished by background thread.
+ * Successful saves show a brief warning message in battlescape or geoscape, failed ones pop up a window with an error message.
+ * @param palette Palette of current state, or null to only log results.
+ */
+void SaveGameState::reportBackgroundSaves(SDL_Color *palette)
+{
+	std::string filename, msg;
+	while (SaveSnapshot::pollBackground(filename, msg))
+	{
+		if (msg.empty())
+		{
+			Log(LOG_INFO) << "Saved " << filename;
+			if (palette == nullptr)
+			{
+				continue;
+			}
+			if (auto* battlescape = _game->getBattlescapeState())
+				battlescape->warning("STR_SAVE_SUCCESSFUL");
+			else if (auto* geoscape = _game->getGeoscapeState())
+				geoscape->warning("STR_SAVE_SUCCESSFUL");
+			continue;
+		}
+		Log(LOG_ERROR) << msg;
+		if (palette == nullptr)
+		{
+			continue;
+		}
+		std::ostringstream error;
+		error << _game->getLanguage()->getString("STR_SAVE_UNSUCCESSFUL") << Unicode::TOK_NL_SMALL << msg;
+		if (_game->getSavedGame() == nullptr || _game->getSavedGame()->getSavedBattle() == nullptr)
+			_game->pushState(new ErrorMessageState(error.str(), palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
+		else
+			_game->pushState(new ErrorMessageState(error.str(), palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
+	}
+}
+
 /**
  * Pops up a window with an error message.
  * @param msg Error message.
@@ -52,6 +52,8 @@ public:
 	void think() override;
 	/// Shows an error message.
 	void error(const std::string &msg);
+	/// Reports results of saves finished in background.
+	static void reportBackgroundSaves(SDL_Color *palette);
 };
 
 }
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "HitChanceTable.h"
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Builds dense table from ruleset values, odd accuracies get average of both neighbours.
+ * @param rulesetValues DistanceRows rows of RulesetColumns values each.
+ */
+void HitChanceTable::build(const std::vector<int>& rulesetValues)
+{
+	_chances.assign(DistanceRows * Columns, 0);
+	for (int distance = 0; distance < DistanceRows; ++distance)
+	{
+		const int* row = &rulesetValues[distance * RulesetColumns];
+		Sint16* chances = &_chances[distance * Columns];
+		for (int accuracy = 0; accuracy <= MaxAccuracy; ++accuracy)
+		{
+			if (accuracy % 2 == 0)
+			{
+				chances[accuracy] = row[accuracy / 2];
+			}
+			else
+			{
+				chances[accuracy] = Round(((double)row[(accuracy - 1) / 2] + (double)row[(accuracy + 1) / 2]) / 2);
+			}
+		}
+	}
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Dense lookup table of Realistic Accuracy hit chances for one unit size.
+ * Ruleset gives values only for even accuracies, odd ones are interpolated once when table is built,
+ * so each query is one clamp and one index.
+ */
+class HitChanceTable
+{
+public:
+	/// Number of distance rows, one per tile.
+	static constexpr int DistanceRows = 40;
+	/// Highest accuracy in table, should be even number.
+	static constexpr int MaxAccuracy = 120;
+	/// Number of values in row of ruleset, accuracy from 0% to MaxAccuracy with 2% step.
+	static constexpr int RulesetColumns = MaxAccuracy / 2 + 1;
+	/// Number of values in row of dense table, every accuracy from 0% to MaxAccuracy.
+	static constexpr int Columns = MaxAccuracy + 1;
+
+private:
+	std::vector<Sint16> _chances;
+
+public:
+	/// Creates empty table.
+	HitChanceTable() = default;
+
+	/// Builds table from ruleset values.
+	void build(const std::vector<int>& rulesetValues);
+	/// Is there any data in table?
+	bool isEmpty() const { return _chances.empty(); }
+
+	/**
+	 * Gets chance to hit for final accuracy and distance, table must not be empty.
+	 * @param distance Distance to target in tiles.
+	 * @param accuracy Final accuracy of a shooter in percents.
+	 * @return Chance to hit in percents.
+	 */
+	int get(int distance, int accuracy) const
+	{
+		if (accuracy < 0) accuracy = 0;
+		if (accuracy > MaxAccuracy) accuracy = MaxAccuracy;
+		if (distance < 1) distance = 1;
+		if (distance > DistanceRows) distance = DistanceRows;
+		return _chances[(distance - 1) * Columns + accuracy];
+	}
+
+	/**
+	 * Applies exposure of target to accuracy, cover only blocks part of shots given by its efficiency.
+	 * @param accuracy Accuracy before cover.
+	 * @param exposure Visible part of target, from 0 to 1.
+	 * @param coverEfficiencyCoeff Efficiency of cover, from 0 to 1.
+	 * @return Accuracy after cover.
+	 */
+	static double applyExposure(double accuracy, double exposure, double coverEfficiencyCoeff)
+	{
+		return accuracy * coverEfficiencyCoeff * exposure + accuracy * (1.0 - coverEfficiencyCoeff);
+	}
+};
+
+}
@@ -1096,11 +1096,12 @@ const std::vector<std::vector<Uint8> > *Mod::getLUTs() const
  * Returns the lookup tables of hit chances.
  * @return Pointer to the list of lookup tables.
  */
-const std::vector<int>* Mod::getHitChancesTable(int size) const
+const HitChanceTable* Mod::getHitChancesTable(int size) const
 {
-	auto it = _hitChancesTable.find(size);
-	if (it != _hitChancesTable.end()) return &it->second;
-
+	if (size >= 0 && size < (int)_hitChancesTables.size() && !_hitChancesTables[size].isEmpty())
+	{
+		return &_hitChancesTables[size];
+	}
 	return nullptr;
 }
 
@@ -3297,9 +3298,9 @@ void Mod::loadFile(const FileMap::FileRecord &filerec, ModScript &parsers)
 		// hitchance file should contain two tables for small and large units
 		// each table has 40 rows, each row represents one distance
 		// each row has 61 values for accuracies from 0 to 120%, step 2%
-		int constexpr TOTAL_TABLE_SIZE = 40 * 61;
+		int constexpr TOTAL_TABLE_SIZE = HitChanceTable::DistanceRows * HitChanceTable::RulesetColumns;
 
-		_hitChancesTable.clear();
+		_hitChancesTables.clear();
 		bool initState = true;
 
 		for (const auto& tableEntryNode : hitChancesNode.children())
@@ -3323,9 +3324,13 @@ void Mod::loadFile(const FileMap::FileRecord &filerec, ModScript &parsers)
 				}
 			}
 
-			if (distanceTable.size() == TOTAL_TABLE_SIZE)
+			if (distanceTable.size() == TOTAL_TABLE_SIZE && unitSize >= 0)
 			{
-				_hitChancesTable[unitSize] = distanceTable;
+				if (unitSize >= (int)_hitChancesTables.size())
+				{
+					_hitChancesTables.resize(unitSize + 1);
+				}
+				_hitChancesTables[unitSize].build(distanceTable);
 			}
 			else
 			{
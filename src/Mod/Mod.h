@@ -34,6 +34,7 @@
 #include "RuleAlienMission.h"
 #include "RuleBaseFacilityFunctions.h"
 #include "RuleItem.h"
+#include "HitChanceTable.h"
 
 namespace OpenXcom
 {
@@ -304,7 +305,7 @@ private:
 	RuleBaseFacilityFunctions _hireScientistsRequiresBaseFunc, _hireEngineersRequiresBaseFunc;
 
     AccuracyModConfig _realisticAccuracyConfig;
-	std::map<int, std::vector<int>> _hitChancesTable;
+	std::vector<HitChanceTable> _hitChancesTables;
 
 	std::string _destroyedFacility;
 	YAML::YamlString _startingBaseDefault, _startingBaseBeginner, _startingBaseExperienced, _startingBaseVeteran, _startingBaseGenius, _startingBaseSuperhuman;
@@ -475,9 +476,9 @@ public:
 	static bool EXTENDED_FORCE_SPAWN;
 
     // Hit chances lookup tables config
-    static const int distanceRows = 40;
-    static const int maxAccuracy = 120; // Should be even number
-    static const int accPerRowCount = 61; // Accuracy from 0% to 120%, with 2% step
+    static const int distanceRows = HitChanceTable::DistanceRows;
+    static const int maxAccuracy = HitChanceTable::MaxAccuracy; // Should be even number
+    static const int accPerRowCount = HitChanceTable::RulesetColumns; // Accuracy from 0% to 120%, with 2% step
 
 	/// Return `true` when given string is empty or pseudo null value.
 	static bool isEmptyRuleName(const std::string& s)
@@ -529,7 +530,16 @@ public:
 	/// Gets parameters for Realistic Accuracy mod
 	const AccuracyModConfig *getAccuracyModConfig() const;
 	/// Gets hit chances lookup table
-	const std::vector<int>* getHitChancesTable(int size) const;
+	const HitChanceTable* getHitChancesTable(int size) const;
+	/// Gets chance to hit target of given size, or accuracy itself when there is no table for it.
+	int getHitChance(int size, int distance, int accuracy) const
+	{
+		if (size >= 0 && size < (int)_hitChancesTables.size() && !_hitChancesTables[size].isEmpty())
+		{
+			return _hitChancesTables[size].get(distance, accuracy);
+		}
+		return accuracy;
+	}
 
 
 	/// Check for obsolete error based on year.
@@ -45,6 +45,7 @@
 #include "../Mod/RuleSoldier.h"
 #include "../Engine/Logger.h"
 #include "../Engine/Collections.h"
+#include "../Engine/ParallelFor.h"
 #include "WeightedOptions.h"
 #include "AlienMission.h"
 #include "Country.h"
@@ -139,33 +140,39 @@ void Base::load(const YAML::YamlNodeReader& reader, SavedGame *save, bool newGam
 			Log(LOG_ERROR) << "Failed to load craft " << type;
 		}
 	}
-	for (const auto& soldierReader : reader["soldiers"].children())
-	{
-		std::string type = soldierReader["type"].readVal(_mod->getSoldiersList().front());
-		if (_mod->getSoldier(type))
+	// soldiers are the biggest part of base, load them by worker threads, they only read crafts and already loaded parts of save
+	const auto soldierReaders = reader["soldiers"].children();
+	parallelAppend((int)soldierReaders.size(), Soldier::getLoadThreadsCount(soldierReaders, _mod), 4, _soldiers,
+		[&](int i) -> Soldier*
 		{
-			Soldier* s = new Soldier(_mod->getSoldier(type), nullptr, 0 /*nationality*/);
-			s->load(soldierReader, _mod, save, _mod->getScriptGlobal());
-			s->setCraft(0);
-			if (const auto& craftIdReader = soldierReader["craft"])
+			const auto& soldierReader = soldierReaders[i];
+			std::string type = soldierReader["type"].readVal(_mod->getSoldiersList().front());
+			if (_mod->getSoldier(type))
 			{
-				CraftId craftId = Craft::loadId(craftIdReader);
-				for (auto* xcraft : _crafts)
+				Soldier* s = new Soldier(_mod->getSoldier(type), nullptr, 0 /*nationality*/);
+				s->load(soldierReader, _mod, save, _mod->getScriptGlobal());
+				s->setCraft(0);
+				if (const auto& craftIdReader = soldierReader["craft"])
 				{
-					if (xcraft->getUniqueId() == craftId)
+					CraftId craftId = Craft::loadId(craftIdReader);
+					for (auto* xcraft : _crafts)
 					{
-						s->setCraft(xcraft);
-						break;
+						if (xcraft->getUniqueId() == craftId)
+						{
+							s->setCraft(xcraft);
+							break;
+						}
 					}
 				}
+				return s;
+			}
+			else
+			{
+				Log(LOG_ERROR) << "Failed to load soldier " << type;
+				return nullptr;
 			}
-			_soldiers.push_back(s);
-		}
-		else
-		{
-			Log(LOG_ERROR) << "Failed to load soldier " << type;
 		}
-	}
+	);
 
 	_items->load(reader["items"], _mod);
 
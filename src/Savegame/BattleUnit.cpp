@@ -35,6 +35,7 @@
 #include "../Battlescape/Inventory.h"
 #include "../Battlescape/TileEngine.h"
 #include "../Battlescape/ExplosionBState.h"
+#include "../Battlescape/UnitGrid.h"
 #include "../Mod/Mod.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Unit.h"
@@ -617,6 +618,10 @@ void BattleUnit::updateArmorFromNonSoldier(const Mod* mod, Armor* newArmor, int
  */
 BattleUnit::~BattleUnit()
 {
+	if (_unitGrid)
+	{
+		_unitGrid->remove(this);
+	}
 	for (auto* buk : _statistics->kills)
 	{
 		delete buk;
@@ -1092,6 +1097,7 @@ int BattleUnit::distance3dToUnitSq(BattleUnit* otherUnit) const
 void BattleUnit::setPosition(Position pos, bool updateLastPos)
 {
 	if (updateLastPos) { _lastPos = _pos; }
+	if (_unitGrid) { _unitGrid->move(this, _pos, pos); }
 	_pos = pos;
 }
 
@@ -1302,7 +1308,11 @@ void BattleUnit::startWalking(int direction, Position destination, SavedBattleGa
 	_walkPhase = 0;
 	_destination = destination;
 	_lastPos = _pos;
-	_kneeled = false;
+	if (_kneeled)
+	{
+		_kneeled = false;
+		savedBattleGame->unitShapeChanged(this);
+	}
 	if (_breathFrame >= 0)
 	{
 		_breathing = false;
@@ -1343,7 +1353,7 @@ void BattleUnit::keepWalking(SavedBattleGame *savedBattleGame, bool fullWalkCycl
 
 	if (!fullWalkCycle)
 	{
-		_pos = _destination;
+		setPosition(_destination, false);
 		end = 2;
 	}
 
@@ -1353,7 +1363,7 @@ void BattleUnit::keepWalking(SavedBattleGame *savedBattleGame, bool fullWalkCycl
 	{
 		// we assume we reached our destination tile
 		// this is actually a drawing hack, so soldiers are not overlapped by floor tiles
-		_pos = _destination;
+		setPosition(_destination, false);
 	}
 
 	if (!fullWalkCycle || (_walkPhase == middle))
@@ -1582,10 +1592,15 @@ const std::vector<std::pair<Uint8, Uint8> > &BattleUnit::getRecolor() const
 /**
  * Kneel down.
  * @param kneeled to kneel or to stand up
+ * @param saveBattleGame Pointer to save to notify about change of unit height.
  */
-void BattleUnit::kneel(bool kneeled)
+void BattleUnit::kneel(bool kneeled, SavedBattleGame *saveBattleGame)
 {
-	_kneeled = kneeled;
+	if (_kneeled != kneeled)
+	{
+		_kneeled = kneeled;
+		saveBattleGame->unitShapeChanged(this);
+	}
 }
 
 /**
@@ -2599,8 +2614,15 @@ bool BattleUnit::addToVisibleTiles(Tile *tile)
 	//Only add once, otherwise we're going to mess up the visibility value and make trouble for the AI (if sneaky).
 	if (_visibleTilesLookup.insert(tile).second)
 	{
+		if (_visibleTiles.empty())
+		{
+			// faction can change before tiles are cleared, remember if they were counted as seen by player
+			_visibleTilesByPlayer = getFaction() == FACTION_PLAYER;
+		}
 		if (getFaction() == FACTION_PLAYER)
 			tile->setVisible(1);
+		if (_visibleTilesByPlayer)
+			tile->changeVisibleToPlayer(1);
 		_visibleTiles.push_back(tile);
 		return true;
 	}
@@ -2672,7 +2694,10 @@ void BattleUnit::clearVisibleTiles()
 	for (auto* tile : _visibleTiles)
 	{
 		tile->setVisible(-1);
+		if (_visibleTilesByPlayer)
+			tile->changeVisibleToPlayer(-1);
 	}
+	_visibleTilesByPlayer = false;
 	_visibleTilesLookup.clear();
 	_visibleTiles.clear();
 	clearLofTiles();
@@ -3710,6 +3735,7 @@ void BattleUnit::setTile(Tile *tile, SavedBattleGame *saveBattleGame)
 	}
 
 	auto armorSize = _armor->getSize() - 1;
+	auto oldTile = _tile;
 	// Reset tiles moved from.
 	if (_tile)
 	{
@@ -3731,6 +3757,8 @@ void BattleUnit::setTile(Tile *tile, SavedBattleGame *saveBattleGame)
 
 	updateTileFloorState(saveBattleGame);
 
+	saveBattleGame->unitTileChanged(this, oldTile);
+
 	if (!_tile)
 	{
 		_floating = false;
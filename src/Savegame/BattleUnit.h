@@ -47,6 +47,7 @@ class Soldier;
 class SavedGame;
 class Language;
 class AIModule;
+class UnitGrid;
 template<typename, typename...> class ScriptContainer;
 template<typename, typename...> class ScriptParser;
 class ScriptWorkerBlit;
@@ -94,6 +95,7 @@ private:
 	std::vector<Tile *> _lofTiles;
 	std::vector<Tile *> _noLofTiles;
 	std::unordered_set<Tile *> _visibleTilesLookup;
+	bool _visibleTilesByPlayer = false;
 	std::unordered_set<Tile *> _lofTilesLookup;
 	std::unordered_set<Tile *> _noLofTilesLookup;
 	int _tu, _energy, _health, _morale, _stunlevel, _mana;
@@ -192,6 +194,7 @@ private:
 	bool _bannedInNextStage;
 	bool _skillMenuCheck;
 	ScriptValues<BattleUnit> _scriptValues;
+	UnitGrid *_unitGrid = nullptr;
 
 	/// Calculate stat improvement.
 	int improveStat(int exp) const;
@@ -257,6 +260,10 @@ public:
 	void setPosition(Position pos, bool updateLastPos = true);
 	/// Gets the unit's position.
 	Position getPosition() const;
+	/// Sets grid that tracks position of unit.
+	void setUnitGrid(UnitGrid *grid) { _unitGrid = grid; }
+	/// Gets grid that tracks position of unit.
+	UnitGrid *getUnitGrid() const { return _unitGrid; }
 	/// Gets the unit's position.
 	Position getLastPosition() const;
 	/// Gets the unit's position of center in voxels.
@@ -312,7 +319,7 @@ public:
 	/// Gets unit sprite recolors values.
 	const std::vector<std::pair<Uint8, Uint8> > &getRecolor() const;
 	/// Kneel down.
-	void kneel(bool kneeled);
+	void kneel(bool kneeled, SavedBattleGame *saveBattleGame);
 	/// Is kneeled?
 	bool isKneeled() const;
 	/// Is floating?
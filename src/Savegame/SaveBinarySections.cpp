@@ -0,0 +1,202 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstring>
+#include "SaveBinarySections.h"
+#include "../Engine/Exception.h"
+
+#define MINIZ_NO_STDIO
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "../../libs/miniz/miniz.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Magic bytes at end of file with binary sections.
+const char FooterMagic[8] = { 'O', 'X', 'B', 'I', 'N', 'S', 'E', 'C' };
+
+/**
+ * Appends little endian integer to buffer.
+ */
+void writeUint(std::string &file, Uint64 value, int bytes)
+{
+	for (int i = 0; i < bytes; ++i)
+	{
+		file.push_back((char)((value >> (8 * i)) & 0xFF));
+	}
+}
+
+/**
+ * Reads little endian integer from buffer and advance position.
+ */
+Uint64 readUint(const Uint8 *data, size_t size, size_t &pos, int bytes)
+{
+	if (pos + bytes > size)
+	{
+		throw Exception("Save file binary section is truncated");
+	}
+	Uint64 value = 0;
+	for (int i = 0; i < bytes; ++i)
+	{
+		value |= (Uint64)data[pos + i] << (8 * i);
+	}
+	pos += bytes;
+	return value;
+}
+
+}
+
+/**
+ * Creates empty set of sections.
+ */
+SaveBinarySections::SaveBinarySections()
+{
+
+}
+
+/**
+ * Cleans up sections.
+ */
+SaveBinarySections::~SaveBinarySections()
+{
+
+}
+
+/**
+ * Adds new section, it is compressed only when written.
+ * @param name Unique name of section.
+ * @param data Uncompressed data.
+ */
+void SaveBinarySections::add(const std::string &name, std::vector<Uint8> data)
+{
+	_sections.push_back(Section{ name, std::move(data) });
+}
+
+/**
+ * Finds section by name.
+ * @param name Name of section.
+ * @return Uncompressed data or null if there is no such section.
+ */
+const std::vector<Uint8> *SaveBinarySections::find(const std::string &name) const
+{
+	for (const auto& section : _sections)
+	{
+		if (section.name == name)
+		{
+			return &section.data;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Appends all sections and footer to content of file.
+ * Each section is stored as name, uncompressed size, compressed size and deflate data.
+ * Footer stores size of YAML part, version, number of sections and magic bytes.
+ * @param file Content of file with YAML documents already written.
+ */
+void SaveBinarySections::write(std::string &file) const
+{
+	if (_sections.empty())
+	{
+		return;
+	}
+	const size_t yamlSize = file.size();
+	std::vector<unsigned char> packed;
+	for (const auto& section : _sections)
+	{
+		mz_ulong packedSize = mz_compressBound((mz_ulong)section.data.size());
+		packed.resize(packedSize);
+		if (mz_compress2(packed.data(), &packedSize, section.data.data(), (mz_ulong)section.data.size(), MZ_BEST_SPEED) != MZ_OK)
+		{
+			throw Exception("Failed to compress save section " + section.name);
+		}
+		writeUint(file, section.name.size(), 4);
+		file += section.name;
+		writeUint(file, section.data.size(), 4);
+		writeUint(file, packedSize, 4);
+		file.append((const char*)packed.data(), packedSize);
+	}
+	writeUint(file, yamlSize, 8);
+	writeUint(file, Version, 4);
+	writeUint(file, _sections.size(), 4);
+	file.append(FooterMagic, sizeof(FooterMagic));
+}
+
+/**
+ * Reads all sections from end of file content.
+ * @param file Content of whole file.
+ * @param size Size of file.
+ * @return Size of YAML part at beginning of file, whole file if there are no sections.
+ */
+size_t SaveBinarySections::read(const void *file, size_t size)
+{
+	_sections.clear();
+	const Uint8 *data = (const Uint8*)file;
+	if (size < FooterSize || memcmp(data + size - sizeof(FooterMagic), FooterMagic, sizeof(FooterMagic)) != 0)
+	{
+		return size;
+	}
+
+	size_t pos = size - FooterSize;
+	const size_t yamlSize = readUint(data, size, pos, 8);
+	const Uint32 version = readUint(data, size, pos, 4);
+	const Uint32 count = readUint(data, size, pos, 4);
+	if (version > Version)
+	{
+		throw Exception("Save file binary sections have unsupported version " + std::to_string(version));
+	}
+	if (yamlSize > size - FooterSize)
+	{
+		throw Exception("Save file binary section is truncated");
+	}
+
+	const size_t end = size - FooterSize;
+	pos = yamlSize;
+	for (Uint32 i = 0; i < count; ++i)
+	{
+		Section section;
+		const size_t nameSize = readUint(data, end, pos, 4);
+		if (pos + nameSize > end)
+		{
+			throw Exception("Save file binary section is truncated");
+		}
+		section.name.assign((const char*)data + pos, nameSize);
+		pos += nameSize;
+		const size_t rawSize = readUint(data, end, pos, 4);
+		const size_t packedSize = readUint(data, end, pos, 4);
+		if (pos + packedSize > end)
+		{
+			throw Exception("Save file binary section is truncated");
+		}
+		section.data.resize(rawSize);
+		mz_ulong unpackedSize = (mz_ulong)rawSize;
+		if (mz_uncompress(section.data.data(), &unpackedSize, data + pos, (mz_ulong)packedSize) != MZ_OK || unpackedSize != rawSize)
+		{
+			throw Exception("Save file binary section " + section.name + " is corrupted");
+		}
+		pos += packedSize;
+		_sections.push_back(std::move(section));
+	}
+	return yamlSize;
+}
+
+}
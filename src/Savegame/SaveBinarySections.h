@@ -0,0 +1,73 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Compressed binary sections stored after YAML documents of save file.
+ * Big blocks of binary data (like battle tiles) are kept out of YAML,
+ * so they do not need base64 encoding and are not scanned by YAML parser.
+ * Sections are followed by fixed size footer, file without footer is plain YAML.
+ * Saves list only read the first YAML document, so it is not affected.
+ */
+class SaveBinarySections
+{
+public:
+	/// Current version of sections format.
+	static constexpr Uint32 Version = 1;
+	/// Size of footer at end of file.
+	static constexpr size_t FooterSize = 24;
+
+private:
+	/**
+	 * Helper struct with one uncompressed section.
+	 */
+	struct Section
+	{
+		std::string name;
+		std::vector<Uint8> data;
+	};
+
+	std::vector<Section> _sections;
+
+public:
+	/// Creates empty set of sections.
+	SaveBinarySections();
+	/// Cleans up sections.
+	~SaveBinarySections();
+
+	/// Adds new section.
+	void add(const std::string &name, std::vector<Uint8> data);
+	/// Finds section by name.
+	const std::vector<Uint8> *find(const std::string &name) const;
+	/// Checks if there is any section.
+	bool empty() const { return _sections.empty(); }
+
+	/// Appends all sections and footer to content of file.
+	void write(std::string &file) const;
+	/// Reads all sections from end of file content.
+	size_t read(const void *file, size_t size);
+};
+
+}
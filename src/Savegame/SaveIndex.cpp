@@ -0,0 +1,178 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SaveIndex.h"
+#include "SaveJournal.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Logger.h"
+
+namespace OpenXcom
+{
+
+const std::string SaveIndex::FILENAME = "saves.idx";
+
+/**
+ * Loads cache of save headers from given folder, broken or old cache is ignored.
+ * @param folder Full path of folder with saves.
+ */
+SaveIndex::SaveIndex(const std::string &folder) : _folder(folder), _changed(false)
+{
+	const std::string path = _folder + FILENAME;
+	if (!CrossPlatform::fileExists(path))
+	{
+		return;
+	}
+	try
+	{
+		_index.reset(new YAML::YamlRootNodeReader(CrossPlatform::readFileRaw(path), path, false));
+		const auto& reader = _index->toBase();
+		if (reader["version"].readVal(0) != Version)
+		{
+			_changed = true;
+			return;
+		}
+		for (const auto& save : reader["saves"].children())
+		{
+			FileStamp stamp;
+			save.readNode("mtime", stamp.mtime);
+			save.readNode("size", stamp.size);
+			save.readNode("journalMtime", stamp.journalMtime);
+			save.readNode("journalSize", stamp.journalSize);
+			const time_t timestamp = (time_t)save["timestamp"].readVal<Sint64>();
+			_entries.emplace(save["file"].readVal<std::string>(), Entry{ stamp, timestamp, save["header"], false });
+		}
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_WARNING) << "Ignoring broken save index " << path << ": " << e.what();
+		_entries.clear();
+		_changed = true;
+	}
+}
+
+/**
+ * Cleans up the cache.
+ */
+SaveIndex::~SaveIndex()
+{
+
+}
+
+/**
+ * Gets current stamp of save file and its journal.
+ * @param filename Name of save file.
+ * @return Stamp of file, zero for files that don't exist.
+ */
+SaveIndex::FileStamp SaveIndex::getStamp(const std::string &filename) const
+{
+	FileStamp stamp;
+	const std::string path = _folder + filename;
+	CrossPlatform::getFileStamp(path, stamp.mtime, stamp.size);
+	CrossPlatform::getFileStamp(SaveJournal::getPath(path), stamp.journalMtime, stamp.journalSize);
+	return stamp;
+}
+
+/**
+ * Gets header of save file, it is only read from disk when file changed since it was cached.
+ * If save has journal that belongs to it, header of journal is used, as it is newer.
+ * @param filename Name of save file.
+ * @param timestamp Date when save was last written.
+ * @return Header of save, valid as long as cache exists.
+ */
+YAML::YamlNodeReader SaveIndex::getHeader(const std::string &filename, time_t &timestamp)
+{
+	const FileStamp stamp = getStamp(filename);
+	auto found = _entries.find(filename);
+	if (found != _entries.end() && found->second.stamp == stamp)
+	{
+		found->second.used = true;
+		timestamp = found->second.timestamp;
+		return found->second.header;
+	}
+
+	const std::string path = _folder + filename;
+	std::unique_ptr<YAML::YamlRootNodeReader> header(new YAML::YamlRootNodeReader(path, true));
+	std::unique_ptr<YAML::YamlRootNodeReader> journal = SaveJournal::readHeader(path, header->toBase());
+	timestamp = CrossPlatform::getDateModified(journal ? SaveJournal::getPath(path) : path);
+	if (journal)
+	{
+		header = std::move(journal);
+	}
+	YAML::YamlNodeReader reader = header->toBase();
+	_headers.push_back(std::move(header));
+
+	if (found != _entries.end())
+	{
+		_entries.erase(found);
+	}
+	_entries.emplace(filename, Entry{ stamp, timestamp, reader, true });
+	_changed = true;
+	return reader;
+}
+
+/**
+ * Writes cache back to disk if any header was read again.
+ * Saves that were not asked for are kept as long as their files exist,
+ * as some lists skip autosaves.
+ */
+void SaveIndex::save()
+{
+	for (auto i = _entries.begin(); i != _entries.end();)
+	{
+		if (!i->second.used && !CrossPlatform::fileExists(_folder + i->first))
+		{
+			i = _entries.erase(i);
+			_changed = true;
+		}
+		else
+		{
+			++i;
+		}
+	}
+	if (!_changed)
+	{
+		return;
+	}
+
+	YAML::YamlRootNodeWriter writer;
+	writer.setAsMap();
+	writer.write("version", Version);
+	YAML::YamlNodeWriter saves = writer["saves"];
+	saves.setAsSeq();
+	for (const auto& i : _entries)
+	{
+		YAML::YamlNodeWriter save = saves.write();
+		save.setAsMap();
+		save.write("file", i.first);
+		save.write("mtime", i.second.stamp.mtime);
+		save.write("size", i.second.stamp.size);
+		save.write("journalMtime", i.second.stamp.journalMtime);
+		save.write("journalSize", i.second.stamp.journalSize);
+		save.write("timestamp", (Sint64)i.second.timestamp);
+		YAML::YamlNodeWriter header = save["header"];
+		header.setAsMap();
+		for (const auto& child : i.second.header.children())
+		{
+			header.writeCopy(child);
+		}
+	}
+	CrossPlatform::writeFile(_folder + FILENAME, writer.emit().yaml);
+	_changed = false;
+}
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <time.h>
+#include <SDL_types.h>
+#include "../Engine/Yaml.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Persistent cache of save file headers used by saves list.
+ * Entries are keyed by file name, precise modification time and size of save file
+ * and its journal, only files with changed stamp are opened again.
+ * Raw headers are stored, not localized info, so changing language or mods
+ * does not make cache stale.
+ */
+class SaveIndex
+{
+	/**
+	 * Helper struct with stamp of file that header was read from.
+	 */
+	struct FileStamp
+	{
+		Uint64 mtime = 0, size = 0;
+		Uint64 journalMtime = 0, journalSize = 0;
+
+		bool operator==(const FileStamp &other) const
+		{
+			return mtime == other.mtime && size == other.size && journalMtime == other.journalMtime && journalSize == other.journalSize;
+		}
+	};
+	/**
+	 * Helper struct with cached header of one save.
+	 */
+	struct Entry
+	{
+		FileStamp stamp;
+		time_t timestamp;
+		YAML::YamlNodeReader header;
+		bool used;
+	};
+
+	std::string _folder;
+	std::unique_ptr<YAML::YamlRootNodeReader> _index;
+	std::vector<std::unique_ptr<YAML::YamlRootNodeReader>> _headers;
+	std::map<std::string, Entry> _entries;
+	bool _changed;
+
+	/// Gets current stamp of save file.
+	FileStamp getStamp(const std::string &filename) const;
+public:
+	/// Name of cache file in user folder.
+	static const std::string FILENAME;
+	/// Current version of cache format.
+	static constexpr int Version = 1;
+
+	/// Loads cache of given folder.
+	SaveIndex(const std::string &folder);
+	/// Cleans up the cache.
+	~SaveIndex();
+	/// Gets header of save file.
+	YAML::YamlNodeReader getHeader(const std::string &filename, time_t &timestamp);
+	/// Writes cache back if anything changed.
+	void save();
+};
+
+}
@@ -0,0 +1,374 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <ctime>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include "SaveJournal.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Content of last full snapshot written to save file.
+ */
+struct Snapshot
+{
+	/// Id shared by snapshot and its journals.
+	std::string id;
+	/// Number of journals written since snapshot.
+	int journals = 0;
+	/// Hash of every top level node.
+	std::unordered_map<std::string, Uint64> nodes;
+	/// Hash of every object in lists, by object id.
+	std::unordered_map<std::string, std::unordered_map<std::string, Uint64>> lists;
+};
+
+/// Snapshots of save files by full path, only used by thread that writes saves.
+std::unordered_map<std::string, Snapshot> _snapshots;
+
+/// Key in header with id of snapshot.
+const ryml::csubstr SnapshotKey = "journalSnapshot";
+
+/**
+ * Checks if node is list of objects with unique ids, that can be compared by object.
+ * @param node Top level node.
+ * @return True if node is such list.
+ */
+bool isList(const YAML::YamlNodeReader &node)
+{
+	if (!node.isSeq())
+	{
+		return false;
+	}
+	std::unordered_set<std::string_view> ids;
+	for (const auto& item : node.children())
+	{
+		if (!item.isMap())
+		{
+			return false;
+		}
+		const auto& id = item["id"];
+		if (!id || !id.hasVal() || !ids.insert(id.val()).second)
+		{
+			return false;
+		}
+	}
+	return !ids.empty();
+}
+
+/**
+ * Generates id of new snapshot, unique across game runs.
+ * @return Id of snapshot.
+ */
+std::string newSnapshotId()
+{
+	std::random_device random;
+	std::ostringstream ss;
+	ss << std::hex << (Uint64)time(0) << "-" << random() << random();
+	return ss.str();
+}
+
+/**
+ * Reads id of snapshot stored in save file.
+ * @param fullPath Full path of save file.
+ * @return Id of snapshot, or empty string if file does not have any.
+ */
+std::string readSnapshotId(const std::string &fullPath)
+{
+	std::string id;
+	if (CrossPlatform::fileExists(fullPath))
+	{
+		try
+		{
+			YAML::YamlRootNodeReader reader(fullPath, true);
+			reader.tryRead(SnapshotKey, id);
+		}
+		catch (std::exception &)
+		{
+			id.clear();
+		}
+	}
+	return id;
+}
+
+/**
+ * Replays changes of list onto objects of snapshot.
+ * @param base List from snapshot.
+ * @param changes Order of objects and changed objects from journal.
+ * @param list Empty list to fill.
+ */
+void replayList(const YAML::YamlNodeReader &base, const YAML::YamlNodeReader &changes, YAML::YamlNodeWriter list)
+{
+	std::unordered_map<std::string_view, YAML::YamlNodeReader> items;
+	for (const auto& item : base.children())
+	{
+		items.emplace(item["id"].val(), item);
+	}
+	for (const auto& item : changes["changed"].children())
+	{
+		const std::string_view id = item["id"].val();
+		items.erase(id);
+		items.emplace(id, item);
+	}
+
+	list.setAsSeq();
+	for (const auto& id : changes["order"].children())
+	{
+		auto item = items.find(id.val());
+		if (item == items.end())
+		{
+			throw Exception("Save journal is missing object " + std::string(id.val()) + " of " + std::string(base.key()));
+		}
+		list.writeCopy(item->second);
+	}
+}
+
+}
+
+/**
+ * Gets path of journal that belongs to save file.
+ * @param fullPath Full path of save file.
+ * @return Full path of journal.
+ */
+std::string SaveJournal::getPath(const std::string &fullPath)
+{
+	return fullPath + ".journal";
+}
+
+/**
+ * Reads only header of journal, used by saves list to show latest state of save.
+ * @param fullPath Full path of save file.
+ * @param header Header of save file.
+ * @return Header of journal, or null if there is no journal that belongs to save.
+ */
+std::unique_ptr<YAML::YamlRootNodeReader> SaveJournal::readHeader(const std::string &fullPath, const YAML::YamlNodeReader &header)
+{
+	std::string id, journalId;
+	const std::string path = getPath(fullPath);
+	if (!header.tryRead(SnapshotKey, id) || !CrossPlatform::fileExists(path))
+	{
+		return nullptr;
+	}
+	std::unique_ptr<YAML::YamlRootNodeReader> journal(new YAML::YamlRootNodeReader(path, true));
+	if (!journal->tryRead(SnapshotKey, journalId) || journalId != id)
+	{
+		return nullptr;
+	}
+	return journal;
+}
+
+/**
+ * Builds journal with all differences between game data and last full snapshot of save file.
+ * Journal is always made against snapshot, not previous journal, so only one journal file is needed.
+ * Full save is needed when there is no known snapshot, file on disk is not that snapshot anymore,
+ * or enough journals were already written.
+ * @param fullPath Full path of save file.
+ * @param header Header of save, it is marked with id of snapshot.
+ * @param body Full game data.
+ * @param journal Empty document to fill with changes.
+ * @param maxJournals Number of journals allowed between full saves.
+ * @return True if journal was made, false if full save is needed.
+ */
+bool SaveJournal::makeJournal(const std::string &fullPath, YAML::YamlNodeWriter header, YAML::YamlNodeWriter body, YAML::YamlNodeWriter journal, int maxJournals)
+{
+	auto found = _snapshots.find(fullPath);
+	if (found == _snapshots.end())
+	{
+		return false;
+	}
+	Snapshot &snapshot = found->second;
+	if (snapshot.journals >= maxJournals || readSnapshotId(fullPath) != snapshot.id)
+	{
+		_snapshots.erase(found);
+		return false;
+	}
+
+	journal.setAsMap();
+	YAML::YamlNodeWriter changed = journal["changed"];
+	changed.setAsMap();
+	YAML::YamlNodeWriter lists = journal["lists"];
+	lists.setAsMap();
+	YAML::YamlNodeWriter removed = journal["removed"];
+	removed.setAsSeq();
+
+	std::unordered_set<std::string> present;
+	for (const auto& node : body.toReader().children())
+	{
+		const std::string key(node.key());
+		present.insert(key);
+		auto oldNode = snapshot.nodes.find(key);
+		if (oldNode == snapshot.nodes.end())
+		{
+			changed.writeCopy(node);
+			continue;
+		}
+		if (oldNode->second == node.hash())
+		{
+			continue;
+		}
+		auto oldList = snapshot.lists.find(key);
+		if (oldList == snapshot.lists.end() || !isList(node))
+		{
+			changed.writeCopy(node);
+			continue;
+		}
+
+		YAML::YamlNodeWriter list = lists[lists.saveString(key)];
+		list.setAsMap();
+		YAML::YamlNodeWriter order = list["order"];
+		order.setAsSeq();
+		order.setFlowStyle();
+		YAML::YamlNodeWriter items = list["changed"];
+		items.setAsSeq();
+		for (const auto& item : node.children())
+		{
+			const std::string id(item["id"].val());
+			order.write(id);
+			auto oldItem = oldList->second.find(id);
+			if (oldItem == oldList->second.end() || oldItem->second != item.hash())
+			{
+				items.writeCopy(item);
+			}
+		}
+	}
+	for (const auto& node : snapshot.nodes)
+	{
+		if (present.find(node.first) == present.end())
+		{
+			removed.write(node.first);
+		}
+	}
+
+	header.write(SnapshotKey, snapshot.id);
+	snapshot.journals++;
+	return true;
+}
+
+/**
+ * Remembers content of full save, so following saves can be written as journals.
+ * @param fullPath Full path of save file.
+ * @param header Header of save, it is marked with id of new snapshot.
+ * @param body Full game data.
+ */
+void SaveJournal::makeSnapshot(const std::string &fullPath, YAML::YamlNodeWriter header, YAML::YamlNodeWriter body)
+{
+	Snapshot &snapshot = _snapshots[fullPath];
+	snapshot = Snapshot();
+	snapshot.id = newSnapshotId();
+	for (const auto& node : body.toReader().children())
+	{
+		const std::string key(node.key());
+		snapshot.nodes[key] = node.hash();
+		if (isList(node))
+		{
+			auto &items = snapshot.lists[key];
+			for (const auto& item : node.children())
+			{
+				items[std::string(item["id"].val())] = item.hash();
+			}
+		}
+	}
+	header.write(SnapshotKey, snapshot.id);
+}
+
+/**
+ * Loads journal of save file, if there is one that belongs to it, and replays it.
+ * Top level nodes are taken from journal when changed there, lists of objects are
+ * rebuilt in order stored in journal from new objects and unchanged objects of snapshot.
+ * Nothing is copied, documents of save file need outlive the journal.
+ * @param fullPath Full path of save file.
+ * @param header Header of save file.
+ * @param body Full game data of save file.
+ */
+SaveJournal::SaveJournal(const std::string &fullPath, const YAML::YamlNodeReader &header, const YAML::YamlNodeReader &body) : _header(header), _body(body)
+{
+	std::string id, journalId;
+	const std::string path = getPath(fullPath);
+	if (!header.tryRead(SnapshotKey, id) || !CrossPlatform::fileExists(path))
+	{
+		return;
+	}
+	std::unique_ptr<YAML::YamlRootNodeReader> journal(new YAML::YamlRootNodeReader(CrossPlatform::readFileRaw(path), path, false));
+	if (!(*journal)[0].tryRead(SnapshotKey, journalId) || journalId != id)
+	{
+		Log(LOG_WARNING) << "Ignoring journal " << path << " of older save";
+		return;
+	}
+
+	const auto& changes = (*journal)[1].useIndex();
+	const auto& changed = changes["changed"].useIndex();
+	const auto& lists = changes["lists"].useIndex();
+	std::unordered_set<std::string_view> removed;
+	for (const auto& key : changes["removed"].children())
+	{
+		removed.insert(key.val());
+	}
+
+	_merged.reset(new YAML::YamlRootNodeWriter());
+	_merged->setAsMap();
+	std::unordered_set<std::string_view> replayed;
+	for (const auto& node : body.children())
+	{
+		const std::string_view key = node.key();
+		const ryml::csubstr keyString = ryml::csubstr(key.data(), key.size());
+		replayed.insert(key);
+		if (removed.find(key) != removed.end())
+		{
+			continue;
+		}
+		if (const auto& change = changed[keyString])
+		{
+			_merged->writeCopy(change);
+		}
+		else if (const auto& list = lists[keyString])
+		{
+			replayList(node, list, (*_merged)[keyString]);
+		}
+		else
+		{
+			_merged->writeCopy(node);
+		}
+	}
+	for (const auto& change : changed.children())
+	{
+		if (replayed.find(change.key()) == replayed.end())
+		{
+			_merged->writeCopy(change);
+		}
+	}
+	_journal = std::move(journal);
+}
+
+/**
+ * Cleans up the journal.
+ */
+SaveJournal::~SaveJournal()
+{
+
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <memory>
+#include "../Engine/Yaml.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Journal of changes made to save file since its last full snapshot.
+ * Full save is written every few saves, saves in between only write top level nodes
+ * that are different than in snapshot to separate journal file next to save file.
+ * Long lists of objects with ids (like mission statistics or dead soldiers) are compared
+ * by object, so journal only stores objects that are new or changed.
+ * Snapshot and journal share unique id in their headers, journal that does not match
+ * its snapshot is ignored, so crash between writing both files can't mix two saves.
+ */
+class SaveJournal
+{
+	std::unique_ptr<YAML::YamlRootNodeReader> _journal;
+	std::unique_ptr<YAML::YamlRootNodeWriter> _merged;
+	YAML::YamlNodeReader _header;
+	YAML::YamlNodeReader _body;
+
+public:
+	/// Gets path of journal that belongs to save file.
+	static std::string getPath(const std::string &fullPath);
+	/// Reads header of journal, if it belongs to save with given header.
+	static std::unique_ptr<YAML::YamlRootNodeReader> readHeader(const std::string &fullPath, const YAML::YamlNodeReader &header);
+
+	/// Builds journal of snapshot against last full save, returns false if full save is needed.
+	static bool makeJournal(const std::string &fullPath, YAML::YamlNodeWriter header, YAML::YamlNodeWriter body, YAML::YamlNodeWriter journal, int maxJournals);
+	/// Remembers content of full save that will be written, marking its header.
+	static void makeSnapshot(const std::string &fullPath, YAML::YamlNodeWriter header, YAML::YamlNodeWriter body);
+
+	/// Loads journal of save file and replays it onto save documents.
+	SaveJournal(const std::string &fullPath, const YAML::YamlNodeReader &header, const YAML::YamlNodeReader &body);
+	/// Cleans up the journal.
+	~SaveJournal();
+	/// Gets header of save, from journal if there was any.
+	YAML::YamlNodeReader getHeader() const { return _journal ? (*_journal)[0] : _header; }
+	/// Gets full game data with journal applied.
+	YAML::YamlNodeReader getBody() const { return _merged ? _merged->toReader() : _body; }
+};
+
+}
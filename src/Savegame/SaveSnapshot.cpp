@@ -0,0 +1,229 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <SDL_thread.h>
+#include "SaveSnapshot.h"
+#include "SaveJournal.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Save that is written by background thread.
+ */
+struct BackgroundSave
+{
+	std::unique_ptr<SaveSnapshot> snapshot;
+	std::string filename;
+	std::string fullPath;
+	std::string error;
+	SDL_Thread *thread = nullptr;
+	std::atomic<bool> done{ false };
+};
+
+/// Save currently written, only used by main thread.
+BackgroundSave *_backgroundSave = nullptr;
+/// Results of finished saves, pairs of file name and error.
+std::deque<std::pair<std::string, std::string>> _backgroundResults;
+
+/**
+ * Emits documents and safely replaces file with them.
+ * Data is first written to backup file and flushed to disk, then renamed over old file,
+ * so crash in middle of saving never leaves broken save behind.
+ * @param fullPath Full path of file.
+ * @param header Document with brief game info.
+ * @param body Document with game data.
+ * @param sections Binary sections stored after documents, can be null.
+ */
+void writeDocuments(const std::string &fullPath, YAML::YamlRootNodeWriter &header, YAML::YamlRootNodeWriter &body, SaveBinarySections *sections)
+{
+	// concatenate header + separator + body
+	// per yaml standard, "bare documents" in a yaml "stream" can be separated by either a "document end" or "directives end" marker line
+	YAML::YamlString headerString = header.emit();
+	std::string directivesEndMarker = "---\n";
+	YAML::YamlString bodyString = body.emit();
+	std::string finalString;
+	finalString.reserve(headerString.yaml.size() + directivesEndMarker.size() + bodyString.yaml.size());
+	finalString += headerString.yaml;
+	finalString += directivesEndMarker;
+	finalString += bodyString.yaml;
+	if (sections)
+	{
+		sections->write(finalString);
+	}
+
+	std::string bakPath = fullPath + ".bak";
+	if (!CrossPlatform::writeFileSync(bakPath, finalString))
+	{
+		throw Exception("Failed to save " + bakPath);
+	}
+	if (!CrossPlatform::moveFile(bakPath, fullPath))
+	{
+		throw Exception("Save backed up in " + bakPath);
+	}
+}
+
+/**
+ * Entry point of background thread.
+ * @param data Pointer to BackgroundSave.
+ * @return Always zero.
+ */
+int SDLCALL runBackgroundSave(void *data)
+{
+	auto *save = (BackgroundSave*)data;
+	try
+	{
+		save->snapshot->write(save->fullPath);
+	}
+	catch (std::exception &e)
+	{
+		save->error = e.what();
+	}
+	// free memory here, big trees take time to release
+	save->snapshot.reset();
+	save->done = true;
+	return 0;
+}
+
+/**
+ * Waits for current background save and stores its result.
+ */
+void finishBackgroundSave()
+{
+	if (!_backgroundSave)
+	{
+		return;
+	}
+	if (_backgroundSave->thread)
+	{
+		SDL_WaitThread(_backgroundSave->thread, nullptr);
+	}
+	_backgroundResults.push_back(std::make_pair(_backgroundSave->filename, _backgroundSave->error));
+	delete _backgroundSave;
+	_backgroundSave = nullptr;
+}
+
+}
+
+/**
+ * Creates empty snapshot.
+ */
+SaveSnapshot::SaveSnapshot() : _body(1000000), _maxJournals(0) //1MB starting buffer of body
+{
+
+}
+
+/**
+ * Cleans up the snapshot.
+ */
+SaveSnapshot::~SaveSnapshot()
+{
+
+}
+
+/**
+ * Emits all documents and writes them to file.
+ * If journals are allowed and last full save of file is known, only journal of changes is written.
+ * Can be called from any thread, but only one at time.
+ * @param fullPath Full path of file.
+ */
+void SaveSnapshot::write(const std::string &fullPath)
+{
+	if (_maxJournals > 0)
+	{
+		YAML::YamlRootNodeWriter journal;
+		if (SaveJournal::makeJournal(fullPath, _header.toBase(), _body.toBase(), journal.toBase(), _maxJournals))
+		{
+			writeDocuments(SaveJournal::getPath(fullPath), _header, journal, nullptr);
+			return;
+		}
+		SaveJournal::makeSnapshot(fullPath, _header.toBase(), _body.toBase());
+	}
+
+	writeDocuments(fullPath, _header, _body, &_sections);
+
+	if (_maxJournals > 0)
+	{
+		// journal of previous snapshot is useless now
+		CrossPlatform::deleteFile(SaveJournal::getPath(fullPath));
+	}
+}
+
+/**
+ * Starts writing snapshot on background thread.
+ * Only one save is written at time, previous one is waited for.
+ * If thread can't be created, snapshot is written immediately.
+ * @param snapshot Snapshot to write, it will be deleted when finished.
+ * @param filename Name of save file in user folder.
+ */
+void SaveSnapshot::writeInBackground(SaveSnapshot *snapshot, const std::string &filename)
+{
+	finishBackgroundSave();
+
+	_backgroundSave = new BackgroundSave();
+	_backgroundSave->snapshot.reset(snapshot);
+	_backgroundSave->filename = filename;
+	_backgroundSave->fullPath = Options::getMasterUserFolder() + filename;
+	_backgroundSave->thread = SDL_CreateThread(runBackgroundSave, _backgroundSave);
+	if (_backgroundSave->thread == nullptr)
+	{
+		// If we can't create the thread, just save it as usual
+		runBackgroundSave(_backgroundSave);
+	}
+}
+
+/**
+ * Gets result of one finished background save, it is removed from queue.
+ * @param filename Name of save file.
+ * @param error Error message, empty if save was successful.
+ * @return True if there was finished save.
+ */
+bool SaveSnapshot::pollBackground(std::string &filename, std::string &error)
+{
+	if (_backgroundSave && _backgroundSave->done)
+	{
+		finishBackgroundSave();
+	}
+	if (_backgroundResults.empty())
+	{
+		return false;
+	}
+	filename = _backgroundResults.front().first;
+	error = _backgroundResults.front().second;
+	_backgroundResults.pop_front();
+	return true;
+}
+
+/**
+ * Waits until background save is finished, its result stays queued for `pollBackground`.
+ */
+void SaveSnapshot::waitBackground()
+{
+	finishBackgroundSave();
+}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include "../Engine/Yaml.h"
+#include "SaveBinarySections.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Complete content of save file that is not yet written.
+ * Building it only copies game state into YAML trees, so it is fast and must be done on main thread.
+ * After that it does not depend on game state and can be emitted and written by background thread,
+ * while game continues.
+ */
+class SaveSnapshot
+{
+	YAML::YamlRootNodeWriter _header;
+	YAML::YamlRootNodeWriter _body;
+	SaveBinarySections _sections;
+	int _maxJournals;
+
+public:
+	/// Creates empty snapshot.
+	SaveSnapshot();
+	/// Cleans up the snapshot.
+	~SaveSnapshot();
+
+	/// Gets document with brief game info used in saves list.
+	YAML::YamlNodeWriter getHeader() { return _header.toBase(); }
+	/// Gets document with full game data.
+	YAML::YamlNodeWriter getBody() { return _body.toBase(); }
+	/// Gets binary sections stored after documents.
+	SaveBinarySections &getSections() { return _sections; }
+
+	/// Allows writing snapshot as journal of last full save.
+	void setMaxJournals(int maxJournals) { _maxJournals = maxJournals; }
+
+	/// Emits snapshot and safely replaces file with it.
+	void write(const std::string &fullPath);
+
+	/// Starts writing snapshot on background thread, takes ownership of snapshot.
+	static void writeInBackground(SaveSnapshot *snapshot, const std::string &filename);
+	/// Gets result of one finished background save.
+	static bool pollBackground(std::string &filename, std::string &error);
+	/// Waits until background save is finished.
+	static void waitBackground();
+};
+
+}
@@ -43,8 +43,11 @@
 #include "../Engine/RNG.h"
 #include "../Engine/Options.h"
 #include "../Engine/Logger.h"
+#include "../Engine/PhaseTimer.h"
+#include "../Engine/Exception.h"
 #include "../Engine/ScriptBind.h"
 #include "SerializationHelper.h"
+#include "SaveBinarySections.h"
 #include "../Mod/RuleStartingCondition.h"
 #include "../Mod/RuleEnviroEffects.h"
 #include "../Mod/RuleItem.h"
@@ -131,8 +134,9 @@ SavedBattleGame::~SavedBattleGame()
  * @param node YAML node.
  * @param mod for the saved game.
  * @param savedGame Pointer to saved game.
+ * @param sections Binary sections of save file, can be null.
  */
-void SavedBattleGame::load(const YAML::YamlNodeReader& node, Mod *mod, SavedGame* savedGame)
+void SavedBattleGame::load(const YAML::YamlNodeReader& node, Mod *mod, SavedGame* savedGame, const SaveBinarySections *sections)
 {
 	const auto& reader = node.useIndex();
 	int mapsize_x = reader["width"].readVal(_mapsize_x);
@@ -213,9 +217,24 @@ void SavedBattleGame::load(const YAML::YamlNodeReader& node, Mod *mod, SavedGame
 		
 
 		// load binary tile data!
-		std::vector<char> binTiles = reader["binTiles"].readValBase64();
-
-		Uint8* ptr = (Uint8*)binTiles.data();
+		std::vector<char> binTiles;
+		Uint8* ptr = nullptr;
+		if (reader["binTilesSection"])
+		{
+			// tiles are read straight from uncompressed section
+			std::string sectionName = reader["binTilesSection"].readVal<std::string>();
+			const std::vector<Uint8>* section = sections ? sections->find(sectionName) : nullptr;
+			if (!section || section->size() < totalTiles * serKey.totalBytes)
+			{
+				throw Exception("Save file is missing binary section " + sectionName);
+			}
+			ptr = const_cast<Uint8*>(section->data());
+		}
+		else
+		{
+			binTiles = reader["binTiles"].readValBase64();
+			ptr = (Uint8*)binTiles.data();
+		}
 		Uint8* dataEnd = ptr + totalTiles * serKey.totalBytes;
 
 		while (ptr < dataEnd)
@@ -484,9 +503,10 @@ void SavedBattleGame::loadMapResources(Mod *mod)
 
 /**
  * Saves the saved battle game to a YAML file.
- * @return YAML node.
+ * @param writer YAML node.
+ * @param sections Binary sections of save file, tiles are stored there if available, otherwise as base64 in YAML.
  */
-void SavedBattleGame::save(YAML::YamlNodeWriter writer) const
+void SavedBattleGame::save(YAML::YamlNodeWriter writer, SaveBinarySections *sections) const
 {
 	writer.setAsMap();
 	if (_vipSurvivalPercentage > 0)
@@ -568,8 +588,8 @@ void SavedBattleGame::save(YAML::YamlNodeWriter writer) const
 	writer.write("lastExploredByHostile", static_cast<char>(Tile::serializationKey._lastExploredByHostile)).setAsQuotedAndEscaped();
 
 	size_t tileDataSize = Tile::serializationKey.totalBytes * _mapsize_z * _mapsize_y * _mapsize_x;
-	Uint8* tileData = (Uint8*) calloc(tileDataSize, 1);
-	Uint8* ptr = tileData;
+	std::vector<Uint8> tileData(tileDataSize, 0);
+	Uint8* ptr = tileData.data();
 
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
@@ -584,8 +604,16 @@ void SavedBattleGame::save(YAML::YamlNodeWriter writer) const
 		}
 	}
 	writer.write("totalTiles", tileDataSize / Tile::serializationKey.totalBytes); // not strictly necessary, just convenient
-	writer.writeBase64("binTiles", (char*)tileData, tileDataSize);
-	free(tileData);
+	if (sections)
+	{
+		tileData.resize(tileDataSize);
+		writer.write("binTilesSection", "tiles");
+		sections->add("tiles", std::move(tileData));
+	}
+	else
+	{
+		writer.writeBase64("binTiles", (char*)tileData.data(), tileDataSize);
+	}
 #endif
 
 	writer.write("nodes", _nodes,
@@ -1089,6 +1117,64 @@ TileEngine *SavedBattleGame::getTileEngine() const
 	return _tileEngine;
 }
 
+/**
+ * Notifies map utilities that some part of tile or state of its door changed.
+ * @param tile Tile that changed.
+ */
+void SavedBattleGame::tileTerrainChanged(Tile *tile)
+{
+	if (_tileEngine)
+	{
+		_tileEngine->tileTerrainChanged(tile);
+	}
+	if (_pathfinding)
+	{
+		_pathfinding->tileTerrainChanged(tile);
+	}
+}
+
+/**
+ * Notifies map utilities that unit left old tile and entered its current tile.
+ * @param unit Unit that moved.
+ * @param oldTile Tile where unit was before, can be null.
+ */
+void SavedBattleGame::unitTileChanged(BattleUnit *unit, Tile *oldTile)
+{
+	if (_tileEngine)
+	{
+		_tileEngine->unitTileChanged(unit, oldTile);
+	}
+	if (_pathfinding)
+	{
+		_pathfinding->unitTileChanged(unit, oldTile);
+	}
+}
+
+/**
+ * Notifies map utilities that unit changed its height (kneeled or stood up) without moving.
+ * Unit can block line of fire between other units, so cached visibility around it is stale.
+ * @param unit Unit that changed.
+ */
+void SavedBattleGame::unitShapeChanged(BattleUnit *unit)
+{
+	if (_tileEngine)
+	{
+		_tileEngine->unitTileChanged(unit, nullptr);
+	}
+}
+
+/**
+ * Notifies map utilities that fire or smoke on tile started, grown or ended.
+ * @param tile Tile that changed.
+ */
+void SavedBattleGame::tileFireOrSmokeChanged(Tile *tile)
+{
+	if (_pathfinding)
+	{
+		_pathfinding->tileFireOrSmokeChanged(tile);
+	}
+}
+
 /**
  * Gets the array of mapblocks.
  * @return Pointer to the array of mapblocks.
@@ -1478,6 +1564,29 @@ const RuleCraftDeployment& SavedBattleGame::getCustomDeployment(const RuleCraft*
  */
 void SavedBattleGame::endTurn()
 {
+	// units can kneel, change armor or die without moving, do not carry visibility checks over to next turn
+	if (_tileEngine)
+	{
+		VisibilityMemo &memo = _tileEngine->getVisibilityMemo();
+		if (Options::traceAI) { Log(LOG_INFO) << "Visibility memo hits: " << memo.getHits() << ", misses: " << memo.getMisses(); }
+		PhaseTimer::addCacheStats(CC_VISIBILITY, memo.getHits(), memo.getMisses());
+		memo.resetStats();
+		_tileEngine->resetVisibilityCache();
+
+		LightSourceCache &lights = _tileEngine->getLightSourceCache();
+		if (Options::traceAI) { Log(LOG_INFO) << "Light source cache hits: " << lights.getHits() << ", misses: " << lights.getMisses() << ", sources: " << lights.getSize(); }
+		PhaseTimer::addCacheStats(CC_LIGHT, lights.getHits(), lights.getMisses());
+		lights.resetStats();
+	}
+	if (_pathfinding)
+	{
+		ReachabilityCache &reachability = _pathfinding->getReachabilityCache();
+		if (Options::traceAI) { Log(LOG_INFO) << "Reachability cache hits: " << reachability.getHits() << ", misses: " << reachability.getMisses(); }
+		PhaseTimer::addCacheStats(CC_REACHABILITY, reachability.getHits(), reachability.getMisses());
+		reachability.resetStats();
+		reachability.flush();
+	}
+
 	// reset turret direction for all hostile and neutral units (as it may have been changed during reaction fire)
 	for (auto* bu : _units)
 	{
@@ -2587,7 +2696,7 @@ void SavedBattleGame::reviveUnconsciousUnits(bool noTU)
 					// recover from unconscious
 					bu->setNotificationShown(0);
 					bu->turn(false); // makes the unit stand up again
-					bu->kneel(false);
+					bu->kneel(false, this);
 					bu->setAlreadyExploded(false);
 					if (noTU)
 					{
@@ -3743,29 +3852,6 @@ void SavedBattleGame::ScriptRegister(ScriptParserBase* parser)
 	sbg.addCustomConst("DIFF_SUPERHUMAN", DIFF_SUPERHUMAN);
 }
 
-/*
-* Used for FOW updates
-* Called in BattleGame popState and init, and when unit is moving in map.cpp
-*/
-void SavedBattleGame::updateVisibleTiles()
-{
-	_currentlyVisibleTiles.clear();
-	for (BattleUnit* unit : _units)
-	{
-		if (unit->getFaction() == FACTION_PLAYER)
-			_currentlyVisibleTiles.insert(unit->getVisibleTiles()->begin(), unit->getVisibleTiles()->end());
-	}
-}
-
-/*
-*
-* Returns true if tile is visible to player
-*/
-bool SavedBattleGame::isTileVisible(Tile* sometile)
-{
-	return (_currentlyVisibleTiles.find(sometile) != _currentlyVisibleTiles.end());
-}
-
 /**
  * Register useful function used by graphic scripts.
  */
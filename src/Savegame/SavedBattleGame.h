@@ -48,6 +48,7 @@ class ItemContainer;
 class Craft;
 class RuleItem;
 class HitLog;
+class SaveBinarySections;
 enum HitLogEntryType : int;
 struct BattlescapeTally;
 
@@ -131,7 +132,6 @@ private:
 	std::string _hiddenMovementBackground;
 	HitLog *_hitLog;
 	ScriptValues<SavedBattleGame> _scriptValues;
-	std::unordered_set<Tile*> _currentlyVisibleTiles;
 	/// Selects a soldier.
 	BattleUnit *selectPlayerUnit(int dir, bool checkReselect = false, bool setReselect = false, bool checkInventory = false);
 	/// Run newTurnUnit and newTurnItem scripts
@@ -142,9 +142,9 @@ public:
 	/// Cleans up the saved game.
 	~SavedBattleGame();
 	/// Loads a saved battle game from YAML.
-	void load(const YAML::YamlNodeReader& reader, Mod *mod, SavedGame* savedGame);
+	void load(const YAML::YamlNodeReader& reader, Mod *mod, SavedGame* savedGame, const SaveBinarySections *sections = nullptr);
 	/// Saves a saved battle game to YAML.
-	void save(YAML::YamlNodeWriter writer) const;
+	void save(YAML::YamlNodeWriter writer, SaveBinarySections *sections = nullptr) const;
 	/// Sets the dimensions of the map and initializes it.
 	void initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool resetTerrain = true);
 	/// Initialises the pathfinding and tile engine.
@@ -390,6 +390,14 @@ public:
 	Pathfinding *getPathfinding() const;
 	/// Gets a pointer to the tile engine.
 	TileEngine *getTileEngine() const;
+	/// Notifies map utilities that terrain of tile changed.
+	void tileTerrainChanged(Tile *tile);
+	/// Notifies map utilities that unit moved to other tile.
+	void unitTileChanged(BattleUnit *unit, Tile *oldTile);
+	/// Notifies map utilities that unit changed its height without moving.
+	void unitShapeChanged(BattleUnit *unit);
+	/// Notifies map utilities that fire or smoke on tile changed.
+	void tileFireOrSmokeChanged(Tile *tile);
 	/// Gets the playing side.
 	UnitFaction getSide() const;
 	/// Can unit use that weapon?
@@ -670,11 +678,6 @@ public:
 	void resetUnitHitStates();
 
 
-	/// used for FOW updates
-	/// called in BattleGame popState and init, and when unit is moving in map.cpp
-	void updateVisibleTiles();
-	/// Returns if tile is visible to player
-	bool isTileVisible(Tile* sometile);
 	/// Returns if the map has objectives that need to be destroyed
 	bool hasObjectives();
 	/// Returns if the map has an exit-zone
@@ -32,8 +32,13 @@
 #include "../Engine/Options.h"
 #include "../Engine/CrossPlatform.h"
 #include "../Engine/ScriptBind.h"
+#include "../Engine/ParallelFor.h"
 #include "SavedBattleGame.h"
 #include "SerializationHelper.h"
+#include "SaveBinarySections.h"
+#include "SaveIndex.h"
+#include "SaveJournal.h"
+#include "SaveSnapshot.h"
 #include "GameTime.h"
 #include "Country.h"
 #include "Base.h"
@@ -255,6 +260,9 @@ static bool _isCurrentGameType(const SaveInfo &saveInfo, const std::string &curM
  */
 std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 {
+	// save still being written would show up half done
+	SaveSnapshot::waitBackground();
+
 	std::vector<SaveInfo> info;
 	std::string curMaster = Options::getActiveMaster();
 	auto saves = CrossPlatform::getFolderContents(Options::getMasterUserFolder(), "sav");
@@ -264,12 +272,13 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 		auto asaves = CrossPlatform::getFolderContents(Options::getMasterUserFolder(), "asav");
 		saves.insert(saves.begin(), asaves.begin(), asaves.end());
 	}
+	SaveIndex index(Options::getMasterUserFolder());
 	for (const auto& tuple : saves)
 	{
 		const auto& filename = std::get<0>(tuple);
 		try
 		{
-			SaveInfo saveInfo = getSaveInfo(filename, lang);
+			SaveInfo saveInfo = getSaveInfo(filename, lang, index);
 			if (!_isCurrentGameType(saveInfo, curMaster))
 			{
 				continue;
@@ -287,6 +296,7 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 			continue;
 		}
 	}
+	index.save();
 
 	return info;
 }
@@ -295,12 +305,12 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
  * Gets the info of a specific save file.
  * @param file Save filename.
  * @param lang Loaded language.
+ * @param index Cache of save headers.
  */
-SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
+SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang, SaveIndex &index)
 {
-	std::string fullname = Options::getMasterUserFolder() + file;
-	YAML::YamlRootNodeReader reader(fullname, true);
 	SaveInfo save;
+	const YAML::YamlNodeReader reader = index.getHeader(file, save.timestamp);
 
 	save.fileName = file;
 
@@ -340,7 +350,6 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 		save.reserved = false;
 	}
 
-	save.timestamp = CrossPlatform::getDateModified(fullname);
 	std::pair<std::string, std::string> str = CrossPlatform::timeToString(save.timestamp);
 	save.isoDate = str.first;
 	save.isoTime = str.second;
@@ -378,17 +387,23 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
  */
 void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 {
+	SaveSnapshot::waitBackground();
+
 	std::string filepath = Options::getMasterUserFolder() + filename;
-	YAML::YamlRootNodeReader documents(filepath, false, false);
+	RawData data = CrossPlatform::readFileRaw(filepath);
+	SaveBinarySections sections;
+	data.shrink(sections.read(data.data(), data.size()));
+	YAML::YamlRootNodeReader documents(data, filepath, false);
+	SaveJournal journal(filepath, documents[0], documents[1]);
 
 	// Get brief save info
-	const auto& header = documents[0];
+	const auto& header = journal.getHeader();
 	_time->load(header["time"]);
 	header.readNode("name", _name, filename);
 	header.tryRead("ironman", _ironman);
 
 	// Get full save data
-	const auto& reader = documents[1].useIndex();
+	const auto& reader = journal.getBody().useIndex();
 	reader.tryRead("difficulty", _difficulty);
 	reader.tryRead("end", _end);
 	if (reader["rng"] && (_ironman || !Options::newSeedOnLoad))
@@ -653,28 +668,35 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 	}
 	_alienStrategy->load(reader["alienStrategy"], mod);
 
-	for (const auto& weHardlyKnewYe : reader["deadSoldiers"].children())
-	{
-		std::string type = weHardlyKnewYe["type"].readVal(mod->getSoldiersList().front());
-		if (mod->getSoldier(type))
-		{
-			Soldier *soldier = new Soldier(mod->getSoldier(type), nullptr, 0 /*nationality*/);
-			soldier->load(weHardlyKnewYe, mod, this, mod->getScriptGlobal());
-			_deadSoldiers.push_back(soldier);
-		}
-		else
+	// dead soldiers only read list of discovered research, they are loaded by worker threads
+	const auto deadSoldierReaders = reader["deadSoldiers"].children();
+	parallelAppend((int)deadSoldierReaders.size(), Soldier::getLoadThreadsCount(deadSoldierReaders, mod), 4, _deadSoldiers,
+		[&](int i) -> Soldier*
 		{
-			Log(LOG_ERROR) << "Failed to load dead soldier " << type;
+			const auto& weHardlyKnewYe = deadSoldierReaders[i];
+			std::string type = weHardlyKnewYe["type"].readVal(mod->getSoldiersList().front());
+			if (mod->getSoldier(type))
+			{
+				Soldier *soldier = new Soldier(mod->getSoldier(type), nullptr, 0 /*nationality*/);
+				soldier->load(weHardlyKnewYe, mod, this, mod->getScriptGlobal());
+				return soldier;
+			}
+			else
+			{
+				Log(LOG_ERROR) << "Failed to load dead soldier " << type;
+				return nullptr;
+			}
 		}
-	}
+	);
 
 	loadTemplates(reader, mod);
 
-	for (const auto& missionStats : reader["missionStatistics"].children())
+	// statistics of all missions are only needed by few screens, keep own copy of yaml until first use
+	if (const auto& missionStatisticsReader = reader["missionStatistics"])
 	{
-		MissionStatistics *ms = new MissionStatistics();
-		ms->load(missionStats);
-		_missionStatistics.push_back(ms);
+		_missionStatisticsNode.reset(new YAML::YamlRootNodeWriter());
+		_missionStatisticsNode->setAsMap();
+		_missionStatisticsNode->writeOwnedCopy(missionStatisticsReader);
 	}
 
 	for (const auto& autoSale : reader["autoSales"].children())
@@ -689,7 +711,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 	if (const YAML::YamlNodeReader& battle = reader["battleGame"])
 	{
 		_battleGame = new SavedBattleGame(mod, lang);
-		_battleGame->load(battle, mod, this);
+		_battleGame->load(battle, mod, this, &sections);
 	}
 
 	_scriptValues.load(reader, mod->getScriptGlobal());
@@ -747,7 +769,18 @@ void saveVector(YAML::YamlNodeWriter& writer, const std::vector<T*>& vector, con
  */
 void SavedGame::save(const std::string &filename, Mod *mod) const
 {
-	YAML::YamlRootNodeWriter headerWriter;
+	SaveSnapshot snapshot;
+	save(snapshot, mod);
+	snapshot.write(Options::getMasterUserFolder() + filename);
+}
+
+/**
+ * Copies a saved game's contents into a snapshot that can be written later.
+ * @param snapshot Empty snapshot to fill.
+ */
+void SavedGame::save(SaveSnapshot &snapshot, Mod *mod) const
+{
+	YAML::YamlNodeWriter headerWriter = snapshot.getHeader();
 	headerWriter.setAsMap();
 	// Saves the brief game info used in the saves list
 
@@ -777,7 +810,7 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 		headerWriter.write("ironman", _ironman);
 
 	// Saves the full game data to the save
-	YAML::YamlRootNodeWriter writer(1000000); //1MB starting buffer
+	YAML::YamlNodeWriter writer = snapshot.getBody();
 	writer.setAsMap();
 	writer.write("difficulty", _difficulty);
 	writer.write("end", _end);
@@ -869,7 +902,12 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 			writer.write(writer.saveString("globalCraftLoadoutName" + std::to_string(j)), _globalCraftLoadoutName[j]);
 	}
 	if (Options::soldierDiaries)
-		saveVector(writer, _missionStatistics, "missionStatistics");
+	{
+		if (_missionStatisticsNode)
+			writer.writeOwnedCopy(_missionStatisticsNode->toReader()["missionStatistics"]);
+		else
+			saveVector(writer, _missionStatistics, "missionStatistics");
+	}
 
 	if (!_autosales.empty())
 	{
@@ -892,25 +930,8 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 		optionInfo.save(optionsWriter);
 
 	if (_battleGame)
-		_battleGame->save(writer["battleGame"]);
-	_scriptValues.save(writer.toBase(), mod->getScriptGlobal());
-
-	// concatenate header + separator + body
-	// per yaml standard, "bare documents" in a yaml "stream" can be separated by either a "document end" or "directives end" marker line
-	YAML::YamlString headerString = headerWriter.emit();
-	std::string directivesEndMarker = "---\n";
-	YAML::YamlString bodyString = writer.emit();
-	std::string finalString;
-	finalString.reserve(headerString.yaml.size() + directivesEndMarker.size() + bodyString.yaml.size());
-	finalString += headerString.yaml;
-	finalString	+= directivesEndMarker;
-	finalString += bodyString.yaml;
-
-	std::string filepath = Options::getMasterUserFolder() + filename;
-	if (!CrossPlatform::writeFile(filepath, finalString))
-	{
-		throw Exception("Failed to save " + filepath);
-	}
+		_battleGame->save(writer["battleGame"], &snapshot.getSections());
+	_scriptValues.save(writer, mod->getScriptGlobal());
 }
 
 /**
@@ -2454,7 +2475,7 @@ int SavedGame::getSoldierIdleDays(const Soldier *soldier)
 	if (lastMissionId == -1)
 		return idleDays;
 
-	for (const auto* missionInfo : _missionStatistics)
+	for (const auto* missionInfo : *getMissionStatistics())
 	{
 		if (missionInfo->id == lastMissionId)
 		{
@@ -3009,10 +3030,21 @@ void SavedGame::setGlobalCraftLoadoutName(int index, const std::string &name)
 
 /**
  * Returns the list of mission statistics.
+ * Statistics kept as yaml from the save are loaded on first call.
  * @return Pointer to statistics list.
  */
 std::vector<MissionStatistics*> *SavedGame::getMissionStatistics()
 {
+	if (_missionStatisticsNode)
+	{
+		for (const auto& missionStats : _missionStatisticsNode->toReader()["missionStatistics"].children())
+		{
+			MissionStatistics *ms = new MissionStatistics();
+			ms->load(missionStats);
+			_missionStatistics.push_back(ms);
+		}
+		_missionStatisticsNode.reset();
+	}
 	return &_missionStatistics;
 }
 
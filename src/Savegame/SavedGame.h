@@ -64,6 +64,8 @@ class EquipmentLayoutItem;
 class ItemContainer;
 class RuleSoldierTransformation;
 class AlienRace;
+class SaveSnapshot;
+class SaveIndex;
 struct MissionStatistics;
 struct BattleUnitKills;
 
@@ -173,13 +175,14 @@ private:
 	std::string _globalCraftLoadoutName[MAX_CRAFT_LOADOUT_TEMPLATES];
 	ItemContainer *_globalCraftLoadout[MAX_CRAFT_LOADOUT_TEMPLATES];
 	std::vector<MissionStatistics*> _missionStatistics;
+	std::unique_ptr<YAML::YamlRootNodeWriter> _missionStatisticsNode;
 	std::set<int> _ignoredUfos;
 	std::set<const RuleItem *> _autosales;
 	bool _disableSoldierEquipment;
 	bool _alienContainmentChecked;
 	ScriptValues<SavedGame> _scriptValues;
 
-	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	static SaveInfo getSaveInfo(const std::string &file, Language *lang, SaveIndex &index);
 public:
 	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
 	/// Creates a new saved game.
@@ -196,6 +199,8 @@ public:
 	void loadUfopediaRuleStatus(const YAML::YamlNodeReader& reader);
 	/// Saves a saved game to YAML.
 	void save(const std::string &filename, Mod *mod) const;
+	/// Copies a saved game into snapshot that can be written later.
+	void save(SaveSnapshot &snapshot, Mod *mod) const;
 	/// Gets the game name.
 	std::string getName() const;
 	/// Sets the game name.
@@ -23,6 +23,7 @@
 #include "../Engine/RNG.h"
 #include "../Engine/Language.h"
 #include "../Engine/Options.h"
+#include "../Engine/ParallelFor.h"
 #include "../Engine/ScriptBind.h"
 #include "Craft.h"
 #include "EquipmentLayoutItem.h"
@@ -55,7 +56,7 @@ Soldier::Soldier(RuleSoldier *rules, Armor *armor, int nationality, int id) :
 	_improvement(0), _psiStrImprovement(0), _rules(rules), _rank(RANK_ROOKIE), _craft(0),
 	_gender(GENDER_MALE), _look(LOOK_BLONDE), _lookVariant(0), _missions(0), _kills(0), _stuns(0),
 	_recentlyPromoted(false), _psiTraining(false), _training(false), _returnToTrainingWhenHealed(false),
-	_armor(armor), _replacedArmor(0), _transformedArmor(0), _personalEquipmentArmor(nullptr), _death(0), _diary(new SoldierDiary()),
+	_armor(armor), _replacedArmor(0), _transformedArmor(0), _personalEquipmentArmor(nullptr), _death(0), _diary(new SoldierDiary()), _diaryMod(nullptr),
 	_corpseRecovered(false),
 	_allowAutoCombat(Options::autoCombatDefaultSoldier), _isLeeroyJenkins(true)
 {
@@ -139,6 +140,31 @@ Soldier::~Soldier()
 	delete _diary;
 }
 
+/**
+ * Gets number of threads that can load given soldiers, `load` only reads mod and save except for the game RNG.
+ * Random transformation bonuses and mana re-rolls of upgraded saves are drawn from the game RNG, when any soldier
+ * needs them all soldiers are loaded by calling thread in order, so the RNG sequence stays the same as always.
+ * @param readers YAML nodes of soldiers.
+ * @param mod Game mod.
+ * @return Number of threads to use.
+ */
+int Soldier::getLoadThreadsCount(const std::vector<YAML::YamlNodeReader>& readers, const Mod *mod)
+{
+	for (const auto& reader : readers)
+	{
+		if (reader["randomTransformationBonuses"])
+		{
+			return 1;
+		}
+		const RuleSoldier *rules = mod->getSoldier(reader["type"].readVal(mod->getSoldiersList().front()));
+		if (rules && rules->getMaxStats().mana > 0 && reader["currentStats"]["mana"].readVal(0) == 0)
+		{
+			return 1;
+		}
+	}
+	return getWorkerThreadsCount(0);
+}
+
 /**
  * Loads the soldier from a YAML file.
  * @param node YAML node.
@@ -237,10 +263,15 @@ void Soldier::load(const YAML::YamlNodeReader& node, const Mod *mod, SavedGame *
 		_death = new SoldierDeath();
 		_death->load(reader["death"]);
 	}
-	if (reader["diary"])
+	if (const auto& diaryReader = reader["diary"])
 	{
+		// diary is rarely needed and can be big, keep its own copy of yaml until first use
+		delete _diary;
 		_diary = new SoldierDiary();
-		_diary->load(reader["diary"], mod);
+		_diaryNode.reset(new YAML::YamlRootNodeWriter());
+		_diaryNode->setAsMap();
+		_diaryNode->writeOwnedCopy(diaryReader);
+		_diaryMod = mod;
 	}
 	calcStatString(mod->getStatStrings(), (Options::psiStrengthEval && save->isResearched(mod->getPsiRequirements())));
 	reader.tryRead("corpseRecovered", _corpseRecovered);
@@ -333,7 +364,12 @@ void Soldier::save(YAML::YamlNodeWriter writer, const ScriptGlobal *shared) cons
 		writer.write("personalEquipmentArmor", _personalEquipmentArmor->getType());
 	if (_death != 0)
 		 _death->save(writer["death"]);
-	if (Options::soldierDiaries && (!_diary->getMissionIdList().empty() || !_diary->getSoldierCommendations()->empty() || _diary->getMonthsService() > 0))
+	if (_diaryNode)
+	{
+		if (Options::soldierDiaries)
+			writer.writeOwnedCopy(_diaryNode->toReader()["diary"]);
+	}
+	else if (Options::soldierDiaries && (!_diary->getMissionIdList().empty() || !_diary->getSoldierCommendations()->empty() || _diary->getMonthsService() > 0))
 		_diary->save(writer["diary"]);
 	if (_corpseRecovered)
 		writer.write("corpseRecovered", _corpseRecovered);
@@ -1518,18 +1554,33 @@ void Soldier::clearEquipmentLayout()
  */
 SoldierDiary *Soldier::getDiary()
 {
+	loadDiary();
 	return _diary;
 }
 const SoldierDiary* Soldier::getDiary() const
 {
+	loadDiary();
 	return _diary;
 }
 
+/**
+ * Loads the diary from yaml that was kept when loading the soldier.
+ */
+void Soldier::loadDiary() const
+{
+	if (_diaryNode)
+	{
+		_diary->load(_diaryNode->toReader()["diary"], _diaryMod);
+		_diaryNode.reset();
+	}
+}
+
 /**
 * Resets the soldier's diary.
 */
 void Soldier::resetDiary()
 {
+	_diaryNode.reset();
 	delete _diary;
 	_diary = new SoldierDiary();
 }
@@ -1728,6 +1779,7 @@ bool Soldier::isEligibleForTransformation(const RuleSoldierTransformation *trans
 		return false;
 
 	// Does the soldier have the required commendations?
+	loadDiary();
 	for (const auto& reqd_comm : transformationRule->getRequiredCommendations())
 	{
 		bool found = false;
@@ -2095,7 +2147,7 @@ const std::vector<const RuleSoldierBonus*> *Soldier::getBonuses(const Mod *mod)
 
 			addSorted(bonusRule);
 		}
-		for (auto commendation : *_diary->getSoldierCommendations())
+		for (auto commendation : *getDiary()->getSoldierCommendations())
 		{
 			auto bonusRule = commendation->getRule()->getSoldierBonus(commendation->getDecorationLevelInt());
 
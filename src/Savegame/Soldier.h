@@ -86,16 +86,22 @@ private:
 	const Armor* _personalEquipmentArmor;
 	SoldierDeath *_death;
 	SoldierDiary *_diary;
+	mutable std::unique_ptr<YAML::YamlRootNodeWriter> _diaryNode;
+	const Mod *_diaryMod;
 	std::string _statString;
 	bool _corpseRecovered;
 	std::map<std::string, int> _previousTransformations, _transformationBonuses;
 	std::vector<const RuleSoldierBonus*> _bonusCache;
 	ScriptValues<Soldier> _scriptValues;
+	/// Loads diary that was kept from save.
+	void loadDiary() const;
 public:
 	/// Creates a new soldier.
 	Soldier(RuleSoldier *rules, Armor *armor, int nationality, int id = 0);
 	/// Cleans up the soldier.
 	~Soldier();
+	/// Gets number of threads that can load given soldiers.
+	static int getLoadThreadsCount(const std::vector<YAML::YamlNodeReader>& readers, const Mod *mod);
 	/// Loads the soldier from YAML.
 	void load(const YAML::YamlNodeReader& reader, const Mod *mod, SavedGame *save, const ScriptGlobal *shared, bool soldierTemplate = false);
 	/// Saves the soldier to YAML.
@@ -284,6 +284,7 @@ void Tile::setMapData(MapData *dat, int mapDataID, int mapDataSetID, TilePart pa
 		_cache.isLadderOnWest = _objects[O_WESTWALL] && _objects[O_WESTWALL]->isGravLift();
 	}
 	updateSprite(part);
+	_save->tileTerrainChanged(this);
 }
 
 /**
@@ -414,6 +415,7 @@ int Tile::openDoor(TilePart part, BattleUnit *unit, BattleActionType reserve, bo
 			return 4;
 		_objectsCache[part].currentFrame = 1; // start opening door
 		updateSprite((TilePart)part);
+		_save->tileTerrainChanged(this);
 		return 1;
 	}
 	if (_objectsCache[part].isUfoDoor && _objectsCache[part].currentFrame != 7) // ufo door != part 7 - door is still opening
@@ -436,6 +438,10 @@ int Tile::closeUfoDoor()
 			updateSprite((TilePart)part);
 		}
 	}
+	if (retval)
+	{
+		_save->tileTerrainChanged(this);
+	}
 
 	return retval;
 }
@@ -701,6 +707,7 @@ void Tile::ignite(int power)
 				_overlaps = 1;
 				_fire = getFuel() + 1;
 				_animationOffset = RNG::generate(0,3);
+				_save->tileFireOrSmokeChanged(this);
 			}
 		}
 	}
@@ -710,12 +717,16 @@ void Tile::ignite(int power)
  * Animate the tile. This means to advance the current frame for every object.
  * Ufo doors are a bit special, they animated only when triggered.
  * When ufo doors are on frame 0(closed) or frame 7(open) they are not animated further.
+ * @return True if any sprite of tile changed.
  */
-void Tile::animate()
+bool Tile::animate()
 {
 	int newframe;
+	bool doorChanged = false;
+	bool spriteChanged = false;
 	for (int i = O_FLOOR; i < O_MAX; ++i)
 	{
+		const Uint8* oldSprite = _currentSurface[i].getBuffer();
 		if (_objects[i])
 		{
 			if (_objectsCache[i].isUfoDoor && (_objectsCache[i].currentFrame == 0 || _objectsCache[i].currentFrame == 7)) // ufo door is static
@@ -731,10 +742,21 @@ void Tile::animate()
 			{
 				newframe = 0;
 			}
+			if (_objectsCache[i].isUfoDoor && _objectsCache[i].currentFrame <= 1 && newframe > 1)
+			{
+				// door is open enough to walk through it
+				doorChanged = true;
+			}
 			_objectsCache[i].currentFrame = newframe;
 		}
 		updateSprite((TilePart)i);
+		spriteChanged |= oldSprite != _currentSurface[i].getBuffer();
+	}
+	if (doorChanged)
+	{
+		_save->tileTerrainChanged(this);
 	}
+	return spriteChanged;
 }
 
 /**
@@ -778,8 +800,13 @@ BattleUnit *Tile::getOverlappingUnit(const SavedBattleGame *saveBattleGame, Tile
  */
 void Tile::setFire(int fire)
 {
+	const int oldFire = _fire;
 	_fire = Clamp(fire, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	if (_fire != oldFire)
+	{
+		_save->tileFireOrSmokeChanged(this);
+	}
 }
 
 /**
@@ -799,6 +826,7 @@ void Tile::addSmoke(int smoke)
 {
 	if (_fire == 0)
 	{
+		const int oldSmoke = _smoke;
 		if (_overlaps == 0)
 		{
 			_smoke = Clamp(_smoke + smoke, 1, 15);
@@ -809,6 +837,10 @@ void Tile::addSmoke(int smoke)
 		}
 		_animationOffset = RNG::generate(0,3);
 		addOverlap();
+		if (_smoke != oldSmoke)
+		{
+			_save->tileFireOrSmokeChanged(this);
+		}
 	}
 }
 
@@ -818,8 +850,13 @@ void Tile::addSmoke(int smoke)
  */
 void Tile::setSmoke(int smoke)
 {
+	const int oldSmoke = _smoke;
 	_smoke = Clamp(smoke, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	if (_smoke != oldSmoke)
+	{
+		_save->tileFireOrSmokeChanged(this);
+	}
 }
 
 
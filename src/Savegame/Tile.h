@@ -130,6 +130,7 @@ protected:
 	Uint8 _explosiveType = 0;
 	Sint16 _explosive = 0;
 	Sint16 _visible = 0;
+	Uint16 _visibleToPlayer = 0;
 	Sint16 _TUMarker = -1;
 	Sint16 _EnergyMarker = -1;
 	Sint8 _preview = -1;
@@ -326,7 +327,7 @@ public:
 	/// Get explosive power of this tile.
 	int getExplosiveType() const;
 	/// Animated the tile parts.
-	void animate();
+	bool animate();
 	/// Update cached value of sprite.
 	void updateSprite(TilePart part);
 	/// Get object sprites.
@@ -394,6 +395,10 @@ public:
 	void setVisible(int visibility);
 	/// Get the tile visible flag.
 	int getVisible() const;
+	/// Changes number of player units that see this tile.
+	void changeVisibleToPlayer(int change) { _visibleToPlayer += change; }
+	/// Is this tile seen by any player unit right now (used by FOW).
+	bool isVisibleToPlayer() const { return _visibleToPlayer > 0; }
 	/// set the direction (used for path previewing)
 	void setPreview(int dir);
 	/// retrieve the direction stored by the pathfinding.
@@ -27,6 +27,8 @@
 #include "Engine/Options.h"
 #include "Engine/FileMap.h"
 #include "Menu/StartState.h"
+#include "Battlescape/AIBenchmark.h"
+#include "Battlescape/HitChanceGenerator.h"
 
 /** @mainpage
  * @author OpenXcom Developers
@@ -119,6 +121,10 @@ int main(int argc, char *argv[])
 	CrossPlatform::processArgs(argc, argv);
 	if (!Options::init())
 		return EXIT_SUCCESS;
+	if (HitChanceGenerator::isActive())
+		return HitChanceGenerator::run() ? EXIT_SUCCESS : EXIT_FAILURE;
+	if (AIBenchmark::isActive())
+		AIBenchmark::setup();
 	std::ostringstream title;
 	title << "OpenXcom " << OPENXCOM_VERSION_SHORT << OPENXCOM_VERSION_GIT;
 	Options::baseXResolution = Options::displayWidth;